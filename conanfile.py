@@ -22,9 +22,11 @@
 # SOFTWARE.
 #
 from conan import ConanFile
+from conan.errors import ConanException
 from conan.tools.build import can_run
 from conan.tools.cmake import CMake, cmake_layout
 from conan.tools.files import load
+import os
 import re
 
 class sqlite3ppRecipe(ConanFile):
@@ -44,11 +46,15 @@ class sqlite3ppRecipe(ConanFile):
         "shared": [True, False], 
         "fPIC": [True, False],
         "with_tests": [True, False],
+        "with_inline": [True, False],
+        "with_session": [True, False],
     }
     default_options = {
         "shared": False,
         "fPIC": True,
-        "with_tests": True
+        "with_tests": True,
+        "with_inline": True,
+        "with_session": False
     }
 
     # Other settings
@@ -62,7 +68,7 @@ class sqlite3ppRecipe(ConanFile):
         self.version = pattern.search(content).group(1)
 
     def requirements(self):
-        self.requires("sqlite3/[>=3.8]")
+        self.requires("sqlite3/[>=3.36]")
         if self.options.with_tests:
             self.test_requires("gtest/1.12.1")
 
@@ -75,12 +81,39 @@ class sqlite3ppRecipe(ConanFile):
             self.options.rm_safe("fPIC")
 
     def package_info(self):
-        self.cpp_info.libs = ["sqlite3pp"]
+        # The package-wide target aggregates all components, so it must not
+        # be sqlite3pp::sqlite3pp, which is the regular library only
+        self.cpp_info.set_property("cmake_target_name", "sqlite3pp::all")
+        core = self.cpp_info.components["core"]
+        core.libs = ["sqlite3pp"]
+        core.requires = ["sqlite3::sqlite3"]
+        core.set_property("cmake_target_name", "sqlite3pp::sqlite3pp")
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            core.system_libs = ["pthread"]
+        if self.options.with_inline:
+            inline = self.cpp_info.components["inline"]
+            inline.libs = ["sqlite3pp_inline"]
+            inline.defines = ["SQLITE3PP_HEADER_ONLY"]
+            inline.requires = ["sqlite3::sqlite3"]
+            inline.set_property("cmake_target_name", "sqlite3pp::inline")
+            if self.settings.os in ["Linux", "FreeBSD"]:
+                inline.system_libs = ["pthread"]
+        if self.options.with_session:
+            for component in self.cpp_info.components.values():
+                component.defines.append("SQLITE3PP_WITH_SESSION")
 
     def build(self):
-        variables = { "SQLITE3PP_WITH_TESTS" : self.options.with_tests }
+        variables = {
+            "SQLITE3PP_WITH_TESTS" : self.options.with_tests,
+            "SQLITE3PP_WITH_INLINE" : self.options.with_inline,
+            "SQLITE3PP_WITH_SESSION" : self.options.with_session
+        }
         cmake = CMake(self)
         cmake.configure(variables)
+        # Consumers get the define, so the build must not fall back silently
+        cache = load(self, os.path.join(self.build_folder, "CMakeCache.txt"))
+        if self.options.with_session and "SQLITE3PP_HAVE_SESSION:INTERNAL=1" not in cache:
+            raise ConanException("sqlite3 is built without session extension")
         cmake.build()
         if self.options.with_tests and can_run(self):
             cmake.test()
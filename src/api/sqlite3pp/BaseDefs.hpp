@@ -29,6 +29,14 @@
 #define SQLITE3PP_EXPORT
 #endif
 
+// Header-only mode defines the row access and stepping in the headers, so
+// they can be inlined into the loops of the caller
+#ifdef SQLITE3PP_HEADER_ONLY
+#define SQLITE3PP_INLINE inline
+#else
+#define SQLITE3PP_INLINE
+#endif
+
 // Forward declaration of internal types
 struct sqlite3;
 struct sqlite3_stmt;
@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "BaseDefs.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+
+namespace sqlite3pp {
+
+// Cancels executions from any thread. Copies share the same state. Running
+// statements notice it at the next check of their limits.
+class SQLITE3PP_EXPORT CancellationToken {
+public:
+    CancellationToken() : m_state{std::make_shared<State>()} {}
+
+    void cancel() const;
+
+    bool isCancelled() const { return m_state->cancelled; }
+
+private:
+    struct State {
+        std::atomic<bool> cancelled{false};
+    };
+
+    std::shared_ptr<State> m_state;
+};
+
+struct ExecutionLimits {
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::optional<CancellationToken> token;
+    // Number of virtual machine instructions between checks of the limits
+    int instructions{1000};
+
+    static ExecutionLimits timeout(std::chrono::steady_clock::duration timeout) {
+        return {std::chrono::steady_clock::now() + timeout, std::nullopt};
+    }
+};
+
+// Enforces the limits on the connection for the lifetime of the guard. The
+// progress handler checks deadline and token. It does not interrupt the
+// whole connection, which would abort statements of other threads. Guards of the same thread on the same
+// connection nest, the innermost one enforces the limits of all outer ones as
+// well. Statements stepped by other threads are not affected by the limits.
+class SQLITE3PP_EXPORT ExecutionGuard {
+public:
+    ExecutionGuard(const ExecutionGuard&) = delete;
+    ExecutionGuard(ExecutionGuard&&) = delete;
+    ExecutionGuard& operator=(const ExecutionGuard&) = delete;
+    ExecutionGuard& operator=(ExecutionGuard&&) = delete;
+    ~ExecutionGuard();
+
+    ExecutionGuard(sqlite3* db, const ExecutionLimits& limits);
+
+private:
+    static int onProgress(void* db);
+    static void install(sqlite3* db);
+
+    bool isExceeded() const;
+
+    sqlite3* m_db;
+    const ExecutionLimits& m_limits;
+    ExecutionGuard* m_outer{nullptr};
+};
+
+} // namespace sqlite3pp
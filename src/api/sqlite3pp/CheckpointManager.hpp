@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "BaseDefs.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace sqlite3pp {
+
+struct CheckpointPolicy {
+    // Run a passive checkpoint once this many frames were appended to the WAL
+    std::size_t frames{1000};
+    // or at the latest after this time, if there are any frames at all
+    std::chrono::milliseconds interval{1000};
+    // Truncate the WAL once there were no commits for this time
+    std::chrono::milliseconds idle{10000};
+};
+
+struct CheckpointStatistics {
+    std::size_t checkpoints{0};
+    std::size_t truncations{0};
+    std::size_t walFrames{0};
+    std::size_t framesCheckpointed{0};
+    std::chrono::microseconds lastDuration{0};
+    std::chrono::microseconds totalDuration{0};
+};
+
+// Moves WAL checkpoints off the commit path. Auto-checkpointing of the given
+// connection is disabled while the manager exists, the WAL growth is observed
+// by the WAL hook and checkpoints run in a background thread on a separate
+// connection to the same database file. A connection can have one manager
+// only, its previous auto-checkpoint setting is restored afterwards.
+class SQLITE3PP_EXPORT CheckpointManager {
+public:
+    CheckpointManager(const CheckpointManager&) = delete;
+    CheckpointManager(CheckpointManager&&) = delete;
+    CheckpointManager& operator=(const CheckpointManager&) = delete;
+    CheckpointManager& operator=(CheckpointManager&&) = delete;
+    ~CheckpointManager();
+
+    CheckpointManager(std::shared_ptr<sqlite3> db, const CheckpointPolicy& policy);
+
+    CheckpointStatistics statistics() const;
+
+private:
+    static int onCommit(void* self, sqlite3* db, const char* database, int frames);
+
+    void run();
+    void checkpoint(bool truncate, std::unique_lock<std::mutex>& lock);
+
+    std::shared_ptr<sqlite3> m_db;
+    std::unique_ptr<sqlite3, int (*)(sqlite3*)> m_checkpointDb{nullptr, nullptr};
+    CheckpointPolicy m_policy;
+    int m_autoCheckpoint{0};
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stop{false};
+    bool m_due{false};
+    std::size_t m_checkpointed{0};
+    std::chrono::steady_clock::time_point m_lastCommit;
+    CheckpointStatistics m_statistics;
+    std::thread m_thread;
+};
+
+} // namespace sqlite3pp
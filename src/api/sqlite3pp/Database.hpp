@@ -24,9 +24,14 @@
 #pragma once
 
 #include "BaseDefs.hpp"
+#include "CheckpointManager.hpp"
+#include "Diagnostics.hpp"
+#include "ResultCache.hpp"
+#include "Session.hpp"
 #include "Statement.hpp"
 #include "Transaction.hpp"
 
+#include <filesystem>
 #include <memory>
 #include <string>
 
@@ -36,7 +41,21 @@ class SQLITE3PP_EXPORT Database {
 public:
     explicit Database(const std::string& uri);
 
-    Statement prepare(const std::string& sql) const { return Statement{m_db, sql}; }
+    // Opens an in-memory database holding a copy of the image
+    static Database fromImage(const Blob& image);
+
+    // Loads the database file into memory. A mapped file is not copied, but
+    // the resulting database is read-only. Changes of a WAL database, which
+    // are not checkpointed into the file yet, are not part of the image.
+    static Database fromImage(const std::filesystem::path& fileName, bool map = false);
+
+    // Returns the image of the database, as it would be stored in a file in
+    // rollback journal mode
+    Blob serialize(const std::string& database = "main") const;
+
+    Statement prepare(const std::string& sql) const {
+        return Statement{m_db, sql, m_diagnostics, m_cache, m_conversion};
+    }
 
     void execute(const std::string& sql) const { prepare(sql).execute(); }
 
@@ -50,17 +69,67 @@ public:
         return prepare(sql).execute<T>();
     }
 
-    Transaction transaction() const { return Transaction{m_db}; }
+    template <typename T>
+    T execute(const std::string& sql, std::size_t expectedRows) const {
+        return prepare(sql).execute<T>(expectedRows);
+    }
+
+    Transaction transaction() const { return Transaction{m_db, m_diagnostics, m_cache, m_conversion}; }
 
     template <typename Action>
     void transaction(const Action& action) const {
-        const auto transaction = Transaction{m_db};
+        const auto transaction = Transaction{m_db, m_diagnostics, m_cache, m_conversion};
         action(transaction);
         transaction.commit();
     }
 
+#ifdef SQLITE3PP_WITH_SESSION
+    Session session(const std::string& database = "main") const { return Session{m_db, database}; }
+
+    void applyChangeset(const Blob& changeset, const Session::ConflictHandler& handler = nullptr) const {
+        Session::apply(m_db, changeset, handler);
+    }
+#endif
+
+    CheckpointManager checkpointManager(const CheckpointPolicy& policy = {}) const {
+        return CheckpointManager{m_db, policy};
+    }
+
+    // Records the query plan of every distinct statement prepared afterwards
+    // and counts its executions. Statements with full table scans, temporary
+    // b-trees or automatic indexes are passed to the handler on report.
+    void enableDiagnostics(Diagnostics::Handler handler) {
+        m_diagnostics = std::make_shared<Diagnostics>(std::move(handler));
+    }
+
+    void reportDiagnostics() const {
+        if (m_diagnostics) {
+            m_diagnostics->report();
+        }
+    }
+
+    // Caches results extracted by statements prepared afterwards, until the
+    // tables they read are modified. Least recently used results are evicted
+    // when the cache exceeds the given number of bytes.
+    void enableResultCache(std::size_t capacity) { m_cache = std::make_shared<ResultCache>(m_db, capacity); }
+
+    ResultCache::Statistics resultCacheStatistics() const {
+        return m_cache ? m_cache->statistics() : ResultCache::Statistics{};
+    }
+
+    // Conversion of column values for statements prepared afterwards
+    void setConversion(Conversion conversion) { m_conversion = conversion; }
+
 private:
+    explicit Database(std::shared_ptr<sqlite3> db) : m_db{std::move(db)} {}
+
+    static Database fromMemory(unsigned char* data, std::size_t size, unsigned int flags,
+                               std::shared_ptr<void> memory);
+
     std::shared_ptr<sqlite3> m_db;
+    std::shared_ptr<Diagnostics> m_diagnostics;
+    std::shared_ptr<ResultCache> m_cache;
+    Conversion m_conversion{Conversion::Strict};
 };
 
 } // namespace sqlite3pp
@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "BaseDefs.hpp"
+#include "QueryPlan.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sqlite3pp {
+
+class Statement;
+
+struct PlanWarning {
+    enum class Kind { FullScan, TempBTree, AutomaticIndex };
+
+    Kind kind;
+    std::string detail;
+};
+
+struct StatementDiagnostics {
+    std::string sql;
+    QueryPlan plan;
+    std::vector<PlanWarning> warnings;
+    std::size_t executions{0};
+};
+
+class SQLITE3PP_EXPORT Diagnostics {
+public:
+    using Handler = std::function<void(const StatementDiagnostics&)>;
+
+    explicit Diagnostics(Handler handler) : m_handler{std::move(handler)} {}
+
+    // Records the plan of the statement once per distinct SQL and returns the
+    // counter, which the statement increments on every execution.
+    std::atomic<std::size_t>& track(const Statement& stmt, const std::string& sql);
+
+    // Calls the handler for every tracked statement with plan warnings
+    void report() const;
+
+    static std::vector<PlanWarning> analyze(const QueryPlan& plan);
+
+private:
+    struct Entry {
+        QueryPlan plan;
+        std::vector<PlanWarning> warnings;
+        std::atomic<std::size_t> executions{0};
+    };
+
+    Handler m_handler;
+    mutable std::mutex m_mutex;
+    std::map<std::string, Entry> m_entries;
+};
+
+} // namespace sqlite3pp
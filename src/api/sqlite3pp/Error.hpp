@@ -30,15 +30,39 @@
 
 namespace sqlite3pp {
 
+// Primary and extended SQLite result code of a failed operation
+struct ErrorCode {
+    int code{0};
+    int extendedCode{0};
+
+    static ErrorCode fromExtended(int extendedCode) {
+        return {extendedCode & 0xFF, extendedCode}; // NOLINT: primary code is the least significant byte
+    }
+
+    bool operator==(const ErrorCode& other) const {
+        return code == other.code && extendedCode == other.extendedCode;
+    }
+    bool operator!=(const ErrorCode& other) const { return !(*this == other); }
+};
+
 class SQLITE3PP_EXPORT Error : public std::runtime_error {
 public:
-    Error(const std::string& what) noexcept : std::runtime_error(what) {}
+    Error(const std::string& what, ErrorCode code = {}) noexcept : std::runtime_error(what), m_code{code} {}
+
+    int getCode() const { return m_code.code; }
+
+    int getExtendedCode() const { return m_code.extendedCode; }
+
+    const ErrorCode& getErrorCode() const { return m_code; }
+
+private:
+    ErrorCode m_code;
 };
 
 class SQLITE3PP_EXPORT OpenDatabaseError : public Error {
 public:
-    OpenDatabaseError(std::string fileName, std::string reason)
-    : Error{"Failed to open database: " + fileName + ": " + reason}, m_fileName{std::move(fileName)} {}
+    OpenDatabaseError(std::string fileName, std::string reason, ErrorCode code = {})
+    : Error{"Failed to open database: " + fileName + ": " + reason, code}, m_fileName{std::move(fileName)} {}
 
     const std::string& getFileName() const { return m_fileName; }
 
@@ -51,8 +75,8 @@ private:
 
 class SQLITE3PP_EXPORT PrepareStatementError : public Error {
 public:
-    PrepareStatementError(const std::string& what, std::string sql)
-    : Error{"Failed to prepare statement: " + what}, m_sql{std::move(sql)} {}
+    PrepareStatementError(const std::string& what, std::string sql, ErrorCode code = {})
+    : Error{"Failed to prepare statement: " + what, code}, m_sql{std::move(sql)} {}
 
     const std::string& getSql() const { return m_sql; }
 
@@ -62,8 +86,8 @@ private:
 
 class SQLITE3PP_EXPORT BindParameterError : public Error {
 public:
-    BindParameterError(const std::string& what, size_t index)
-    : Error{"Failed to bind paramter " + std::to_string(index) + ": " + what}, m_index{index} {}
+    BindParameterError(const std::string& what, size_t index, ErrorCode code = {})
+    : Error{"Failed to bind paramter " + std::to_string(index) + ": " + what, code}, m_index{index} {}
 
     size_t getIndex() const { return m_index; }
 
@@ -73,8 +97,8 @@ private:
 
 class SQLITE3PP_EXPORT TypeMismatchError : public Error {
 public:
-    TypeMismatchError(size_t index)
-    : Error{"Result type mismatch in column " + std::to_string(index)}, m_index{index} {}
+    TypeMismatchError(size_t index, ErrorCode code = {})
+    : Error{"Result type mismatch in column " + std::to_string(index), code}, m_index{index} {}
 
     size_t getIndex() const { return m_index; }
 
@@ -82,4 +106,14 @@ private:
     size_t m_index;
 };
 
+class SQLITE3PP_EXPORT InterruptedError : public Error {
+public:
+    InterruptedError(ErrorCode code = {}) : Error{"Execution interrupted", code} {}
+};
+
+class SQLITE3PP_EXPORT SessionError : public Error {
+public:
+    SessionError(const std::string& what, ErrorCode code = {}) : Error{"Session failed: " + what, code} {}
+};
+
 } // namespace sqlite3pp
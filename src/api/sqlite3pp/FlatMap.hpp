@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sqlite3pp {
+
+class Statement;
+
+// Read-only map stored as a sorted vector. Lookups are binary searches over
+// contiguous memory, which is cheaper than a tree for maps filled only once.
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+    using iterator = const_iterator;
+
+    FlatMap() = default;
+
+    // Like std::map, the first value of a duplicate key wins
+    explicit FlatMap(std::vector<value_type> values) : m_values{std::move(values)} { normalize(); }
+
+    const_iterator begin() const { return m_values.begin(); }
+    const_iterator end() const { return m_values.end(); }
+    std::size_t size() const { return m_values.size(); }
+    bool empty() const { return m_values.empty(); }
+    std::size_t capacity() const { return m_values.capacity(); }
+
+    const_iterator find(const K& key) const {
+        const auto less = [this](const auto& value, const auto& other) { return m_compare(value.first, other); };
+        const auto it = std::lower_bound(begin(), end(), key, less);
+        return end() != it && !m_compare(key, it->first) ? it : end();
+    }
+
+    bool contains(const K& key) const { return end() != find(key); }
+    std::size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    const V& at(const K& key) const {
+        const auto it = find(key);
+        if (end() == it) {
+            throw std::out_of_range{"Key not found in FlatMap"};
+        }
+        return it->second;
+    }
+
+    void reserve(std::size_t size) { m_values.reserve(size); }
+
+    bool operator==(const FlatMap& other) const { return m_values == other.m_values; }
+    bool operator!=(const FlatMap& other) const { return m_values != other.m_values; }
+
+private:
+    friend class Statement;
+
+    // Statement appends unsorted rows and normalizes once after the last one
+    void normalize() {
+        const auto less = [this](const auto& lhs, const auto& rhs) { return m_compare(lhs.first, rhs.first); };
+        const auto equal = [this](const auto& lhs, const auto& rhs) {
+            return !m_compare(lhs.first, rhs.first) && !m_compare(rhs.first, lhs.first);
+        };
+        std::stable_sort(m_values.begin(), m_values.end(), less);
+        m_values.erase(std::unique(m_values.begin(), m_values.end(), equal), m_values.end());
+    }
+
+    std::vector<value_type> m_values;
+    Compare m_compare;
+};
+
+} // namespace sqlite3pp
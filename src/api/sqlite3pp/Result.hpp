@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "BaseDefs.hpp"
+#include "Error.hpp"
+
+#include <optional>
+#include <utility>
+#include <variant>
+
+namespace sqlite3pp {
+
+// Either a value or the error code of the failed operation. Used by the
+// non-throwing API for failures, which are expected and frequent, e.g.
+// constraint violations or busy databases.
+template <typename T>
+class Result {
+public:
+    Result(T value) : m_value{std::in_place_index<0>, std::move(value)} {}
+    Result(ErrorCode error) : m_value{std::in_place_index<1>, error} {}
+
+    bool hasValue() const { return 0 == m_value.index(); }
+
+    explicit operator bool() const { return hasValue(); }
+
+    const T& value() const& {
+        if (!hasValue()) {
+            throw Error{"Result holds an error", error()};
+        }
+        return std::get<0>(m_value);
+    }
+
+    T&& value() && {
+        if (!hasValue()) {
+            throw Error{"Result holds an error", error()};
+        }
+        return std::get<0>(std::move(m_value));
+    }
+
+    const T& operator*() const& { return std::get<0>(m_value); }
+
+    T&& operator*() && { return std::get<0>(std::move(m_value)); }
+
+    const T* operator->() const { return &std::get<0>(m_value); }
+
+    ErrorCode error() const { return hasValue() ? ErrorCode{} : std::get<1>(m_value); }
+
+private:
+    std::variant<T, ErrorCode> m_value;
+};
+
+template <>
+class Result<void> {
+public:
+    Result() = default;
+    Result(ErrorCode error) : m_error{error} {}
+
+    bool hasValue() const { return !m_error.has_value(); }
+
+    explicit operator bool() const { return hasValue(); }
+
+    void value() const {
+        if (!hasValue()) {
+            throw Error{"Result holds an error", error()};
+        }
+    }
+
+    ErrorCode error() const { return m_error.value_or(ErrorCode{}); }
+
+private:
+    std::optional<ErrorCode> m_error;
+};
+
+} // namespace sqlite3pp
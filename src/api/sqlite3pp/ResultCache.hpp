@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "BaseDefs.hpp"
+
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace sqlite3pp {
+
+// Caches extracted query results per SQL, bound parameters and result type.
+// Tables read by a statement are discovered by the authorizer during prepare.
+// Cached results are invalidated by the update, commit and rollback hooks as
+// well as by statements writing to those tables. Only changes made through
+// the same connection are observed. Statements calling built-in functions
+// with varying results, like random() or date('now'), or reading internal
+// tables, like sqlite_sequence, are never cached.
+// Application-defined functions must be deterministic.
+class SQLITE3PP_EXPORT ResultCache {
+public:
+    struct Footprint {
+        std::vector<std::uint64_t*> reads;
+        std::vector<std::uint64_t*> writes;
+        bool schemaChange{false};
+        bool rollback{false};
+        bool nondeterministic{false};
+    };
+
+    struct Statistics {
+        std::size_t hits{0};
+        std::size_t misses{0};
+        std::size_t entries{0};
+        std::size_t bytes{0};
+    };
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache(ResultCache&&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+    ResultCache& operator=(ResultCache&&) = delete;
+    ~ResultCache();
+
+    ResultCache(std::shared_ptr<sqlite3> db, std::size_t capacity);
+
+    // Runs the prepare action and returns the tables it touches
+    Footprint collect(const std::function<void()>& prepare);
+
+    std::optional<std::any> find(const std::string& key, std::type_index type);
+
+    void insert(const std::string& key, std::type_index type, const Footprint& footprint, std::any value,
+                std::size_t bytes);
+
+    // Invalidates the results affected by an executed statement
+    void invalidate(const Footprint& footprint);
+
+    Statistics statistics() const;
+
+private:
+    struct Names {
+        std::set<std::string> reads;
+        std::set<std::string> writes;
+        bool schemaChange{false};
+        bool rollback{false};
+        bool nondeterministic{false};
+    };
+
+    struct Key {
+        std::string sql;
+        std::type_index type;
+
+        bool operator==(const Key& other) const { return type == other.type && sql == other.sql; }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<std::string>{}(key.sql) ^ (key.type.hash_code() * 31);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::any value;
+        std::size_t bytes;
+        std::uint64_t epoch;
+        std::vector<std::pair<const std::uint64_t*, std::uint64_t>> versions;
+    };
+
+    static int onAuthorize(void* self, int action, const char* arg1, const char* arg2, const char* database,
+                           const char* trigger);
+    static void onUpdate(void* self, int operation, const char* database, const char* table, long long rowid);
+    static int onCommit(void* self);
+    static void onRollback(void* self);
+
+    std::uint64_t* version(const std::string& table);
+    void evict(std::list<Entry>::iterator entry);
+    void detach();
+
+    std::shared_ptr<sqlite3> m_db;
+    std::size_t m_capacity;
+    mutable std::mutex m_mutex;
+    std::mutex m_prepareMutex;
+    Names* m_names{nullptr};
+    bool m_attached{true};
+    std::uint64_t m_epoch{0};
+    std::unordered_map<std::string, std::uint64_t> m_versions;
+    std::set<std::uint64_t*> m_dirty;
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+    Statistics m_statistics;
+};
+
+} // namespace sqlite3pp
@@ -24,8 +24,12 @@
 #pragma once
 
 #include "BaseDefs.hpp"
+#include "Error.hpp"
+#include "Result.hpp"
 
 #include <cstdint>
+#include <limits>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,29 +38,103 @@ namespace sqlite3pp {
 
 using Blob = std::vector<std::uint8_t>;
 
+enum class Conversion {
+    // Values are read only from their own storage class, NULL only into std::optional
+    Strict,
+    // Values are converted between storage classes like SQLite does. Text is
+    // read as number only, if it is a well-formed number.
+    Affinity
+};
+
+// Resolved once per statement, so reading a value needs no declared types
+struct ColumnConversion {
+    Conversion policy{Conversion::Strict};
+    // Columns with numeric affinity store text only, if it is not a number
+    std::vector<bool> numericAffinity;
+};
+
 class SQLITE3PP_EXPORT Row {
 public:
-    explicit Row(sqlite3_stmt* stmt) : m_stmt{stmt} {}
+    explicit Row(sqlite3_stmt* stmt, const ColumnConversion* conversion = nullptr)
+    : m_stmt{stmt}, m_conversion{conversion} {}
 
     template <typename T>
     T get(std::size_t index) const {
         T result{};
-        get(index, result);
+        if (!read(index, result)) {
+            throw TypeMismatchError{index, mismatch()};
+        }
+        return result;
+    }
+
+    template <typename T>
+    Result<T> tryGet(std::size_t index) const {
+        T result{};
+        if (!read(index, result)) {
+            return mismatch();
+        }
         return result;
     }
 
 private:
     sqlite3_stmt* m_stmt;
+    const ColumnConversion* m_conversion;
+
+    static ErrorCode mismatch();
 
+    // Whether the column can be read as the given storage class
+    bool readable(std::size_t index, int type) const;
+
+    bool isNull(std::size_t index) const;
+
+    // Each read advances the index to the next column, unless the column
+    // does not match the requested type
     template <typename K, typename V>
-    std::size_t get(std::size_t index, std::pair<K, V>& result) const {
-        return get(get(index, result.first), result.second);
+    bool read(std::size_t& index, std::pair<K, V>& result) const {
+        return read(index, result.first) && read(index, result.second);
+    }
+
+    template <typename T>
+    bool read(std::size_t& index, std::optional<T>& result) const {
+        if (isNull(index)) {
+            result.reset();
+            ++index;
+            return true;
+        }
+        T value{};
+        if (!read(index, value)) {
+            return false;
+        }
+        result = std::move(value);
+        return true;
     }
 
-    std::size_t get(std::size_t index, int& value) const;
-    std::size_t get(std::size_t index, double& value) const;
-    std::size_t get(std::size_t index, std::string& value) const;
-    std::size_t get(std::size_t index, Blob& value) const;
+    // Integers out of range of the requested type do not match
+    template <typename T>
+    bool readInteger(std::size_t& index, T& value) const {
+        auto column = index;
+        std::int64_t wide{0};
+        if (!read(column, wide) || static_cast<std::int64_t>(std::numeric_limits<T>::min()) > wide ||
+            static_cast<std::int64_t>(std::numeric_limits<T>::max()) < wide) {
+            return false;
+        }
+        value = static_cast<T>(wide);
+        index = column;
+        return true;
+    }
+
+    bool read(std::size_t& index, std::int64_t& value) const;
+    bool read(std::size_t& index, int& value) const { return readInteger(index, value); }
+    bool read(std::size_t& index, std::uint32_t& value) const { return readInteger(index, value); }
+    bool read(std::size_t& index, bool& value) const;
+    bool read(std::size_t& index, double& value) const;
+    bool read(std::size_t& index, float& value) const;
+    bool read(std::size_t& index, std::string& value) const;
+    bool read(std::size_t& index, Blob& value) const;
 };
 
 } // namespace sqlite3pp
+
+#ifdef SQLITE3PP_HEADER_ONLY
+#include "RowInline.hpp"
+#endif
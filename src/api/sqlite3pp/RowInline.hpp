@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "Row.hpp"
+
+#include <sqlite3.h>
+
+namespace sqlite3pp {
+
+SQLITE3PP_INLINE ErrorCode Row::mismatch() { return {SQLITE_MISMATCH, SQLITE_MISMATCH}; }
+
+SQLITE3PP_INLINE bool Row::isNull(std::size_t index) const {
+    // SQLite reports columns past the end as NULL as well
+    return static_cast<int>(index) < sqlite3_column_count(m_stmt) &&
+           SQLITE_NULL == sqlite3_column_type(m_stmt, static_cast<int>(index));
+}
+
+SQLITE3PP_INLINE bool Row::readable(std::size_t index, int type) const {
+    const auto actual = sqlite3_column_type(m_stmt, static_cast<int>(index));
+    if (type == actual) {
+        return true;
+    }
+    if (nullptr == m_conversion || Conversion::Strict == m_conversion->policy || SQLITE_NULL == actual) {
+        return false;
+    }
+    // SQLite converts the value on access, but only well-formed text has a
+    // numeric meaning
+    if (SQLITE_INTEGER != type && SQLITE_FLOAT != type) {
+        return true;
+    }
+    if (SQLITE_TEXT != actual) {
+        return SQLITE_BLOB != actual;
+    }
+    if (m_conversion->numericAffinity[index]) {
+        return false;
+    }
+    const auto numeric = sqlite3_value_numeric_type(sqlite3_column_value(m_stmt, static_cast<int>(index)));
+    return SQLITE_INTEGER == numeric || SQLITE_FLOAT == numeric;
+}
+
+SQLITE3PP_INLINE bool Row::read(std::size_t& index, std::int64_t& value) const {
+    if (!readable(index, SQLITE_INTEGER)) {
+        return false;
+    }
+    value = sqlite3_column_int64(m_stmt, static_cast<int>(index++));
+    return true;
+}
+
+SQLITE3PP_INLINE bool Row::read(std::size_t& index, bool& value) const {
+    std::int64_t integer{0};
+    if (!read(index, integer)) {
+        return false;
+    }
+    value = 0 != integer;
+    return true;
+}
+
+SQLITE3PP_INLINE bool Row::read(std::size_t& index, double& value) const {
+    if (!readable(index, SQLITE_FLOAT)) {
+        return false;
+    }
+    value = sqlite3_column_double(m_stmt, static_cast<int>(index++));
+    return true;
+}
+
+SQLITE3PP_INLINE bool Row::read(std::size_t& index, float& value) const {
+    double real{0};
+    if (!read(index, real)) {
+        return false;
+    }
+    value = static_cast<float>(real);
+    return true;
+}
+
+SQLITE3PP_INLINE bool Row::read(std::size_t& index, std::string& value) const {
+    if (!readable(index, SQLITE_TEXT)) {
+        return false;
+    }
+    const auto* text = sqlite3_column_text(m_stmt, static_cast<int>(index));
+    const auto length = sqlite3_column_bytes(m_stmt, static_cast<int>(index++));
+    value.assign(text, text + length); // NOLINT: bridge to C-code
+    return true;
+}
+
+SQLITE3PP_INLINE bool Row::read(std::size_t& index, Blob& value) const {
+    if (!readable(index, SQLITE_BLOB)) {
+        return false;
+    }
+    const auto* data = static_cast<Blob::const_pointer>(sqlite3_column_blob(m_stmt, static_cast<int>(index)));
+    const auto length = sqlite3_column_bytes(m_stmt, static_cast<int>(index++));
+    value.assign(data, data + length); // NOLINT: bridge to C-code
+    return true;
+}
+
+} // namespace sqlite3pp
@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "BaseDefs.hpp"
+#include "Row.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+// Only available, if the library was built with the session extension
+#ifdef SQLITE3PP_WITH_SESSION
+
+struct sqlite3_session;
+
+namespace sqlite3pp {
+
+struct Conflict {
+    enum class Type { Data, NotFound, Conflict, Constraint, ForeignKey };
+    enum class Operation { Insert, Update, Delete };
+
+    Type type;
+    Operation operation;
+    std::string table;
+};
+
+enum class ConflictAction { Omit, Replace, Abort };
+
+// Records changes on attached tables of a database, so they can be extracted
+// as changeset or patchset and applied to another database.
+class SQLITE3PP_EXPORT Session {
+public:
+    using ConflictHandler = std::function<ConflictAction(const Conflict&)>;
+
+    explicit Session(std::shared_ptr<sqlite3> db, const std::string& database = "main");
+
+    void attach(const std::string& table) const;
+
+    // Records changes on all tables of the database
+    void attach() const;
+
+    bool isEmpty() const;
+
+    Blob changeset() const;
+
+    Blob patchset() const;
+
+    // Without a handler any conflict aborts the whole changeset
+    static void apply(const std::shared_ptr<sqlite3>& db, const Blob& changeset,
+                      const ConflictHandler& handler = nullptr);
+
+private:
+    std::shared_ptr<sqlite3> m_db;
+    std::unique_ptr<sqlite3_session, void (*)(sqlite3_session*)> m_session{nullptr, nullptr};
+};
+
+} // namespace sqlite3pp
+
+#endif // SQLITE3PP_WITH_SESSION
@@ -24,19 +24,32 @@
 #pragma once
 
 #include "BaseDefs.hpp"
+#include "Cancellation.hpp"
+#include "FlatMap.hpp"
+#include "QueryPlan.hpp"
+#include "Result.hpp"
+#include "ResultCache.hpp"
 #include "Row.hpp"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace sqlite3pp {
 
+class Diagnostics;
+
 class SQLITE3PP_EXPORT Statement {
 public:
-    Statement(std::shared_ptr<sqlite3> db, const std::string& sql);
+    Statement(std::shared_ptr<sqlite3> db, const std::string& sql, std::shared_ptr<Diagnostics> diagnostics = nullptr,
+              std::shared_ptr<ResultCache> cache = nullptr, Conversion conversion = Conversion::Strict);
+
+    void setConversion(Conversion conversion) { m_conversion.policy = conversion; }
 
     void bind(size_t index, int value) const;
     void bind(size_t index, double value) const;
@@ -45,8 +58,11 @@ public:
 
     template <typename Handler>
     void execute(const Handler& handler) const {
+        if (nullptr != m_executions) {
+            ++*m_executions;
+        }
         while (hasNext()) {
-            handler(Row{m_stmt.get()});
+            handler(row());
         }
     }
 
@@ -56,12 +72,98 @@ public:
 
     template <typename T>
     T execute() const {
+        return execute<T>(std::size_t{0});
+    }
+
+    // Containers reserve room for the expected number of rows up front
+    template <typename T>
+    T execute(std::size_t expectedRows) const {
+        if (m_cacheable) {
+            return executeCached<T>(expectedRows);
+        }
         T result{};
+        reserve(result, expectedRows);
         execute([&result](const auto& row) { get(row, result); });
+        finish(result);
         return result;
     }
 
+    // Variants with limits throw InterruptedError once the deadline passed or
+    // the token was cancelled. The statement can be executed again afterwards.
+    template <typename Handler>
+    void execute(const Handler& handler, const ExecutionLimits& limits) const {
+        const ExecutionGuard guard{m_db.get(), limits};
+        execute(handler);
+    }
+
+    void execute(const ExecutionLimits& limits) const {
+        execute([](const auto&) {}, limits);
+    }
+
+    template <typename T>
+    T execute(const ExecutionLimits& limits) const {
+        const ExecutionGuard guard{m_db.get(), limits};
+        return execute<T>();
+    }
+
+    template <typename Handler>
+    Result<void> tryExecute(const Handler& handler, const ExecutionLimits& limits) const {
+        const ExecutionGuard guard{m_db.get(), limits};
+        return tryExecute(handler);
+    }
+
+    // Non-throwing variants report failures of the steps as error codes
+    template <typename Handler>
+    Result<void> tryExecute(const Handler& handler) const {
+        if (nullptr != m_executions) {
+            ++*m_executions;
+        }
+        for (;;) {
+            const auto next = tryStep();
+            if (!next) {
+                return next.error();
+            }
+            if (!*next) {
+                return {};
+            }
+            handler(row());
+        }
+    }
+
+    Result<void> tryExecute() const {
+        return tryExecute([](const auto&) {});
+    }
+
+    // Advances to the next row, returns false once the statement is done
+    Result<bool> tryStep() const;
+
+    Row row() const { return Row{m_stmt.get(), &m_conversion}; }
+
+    QueryPlan queryPlan() const;
+
 private:
+    template <typename T>
+    T executeCached(std::size_t expectedRows) const {
+        const auto key = cacheKey();
+        if (auto cached = m_cache->find(key, typeid(T))) {
+            // Hits count as executions, misses are counted by execute below
+            if (nullptr != m_executions) {
+                ++*m_executions;
+            }
+            return std::any_cast<T>(std::move(*cached));
+        }
+        T result{};
+        reserve(result, expectedRows);
+        std::size_t bytes{0};
+        execute([this, &result, &bytes](const auto& row) {
+            get(row, result);
+            bytes += rowBytes();
+        });
+        finish(result);
+        m_cache->insert(key, typeid(T), m_footprint, result, bytes);
+        return result;
+    }
+
     static void get(const Row& row, Blob& result) { result = row.get<Blob>(0); }
 
     template <typename T>
@@ -84,10 +186,73 @@ private:
         results.insert(row.get<std::pair<K, V>>(0));
     }
 
+    template <typename T>
+    static void get(const Row& row, std::unordered_set<T>& results) {
+        results.insert(row.get<T>(0));
+    }
+
+    template <typename K, typename V>
+    static void get(const Row& row, std::unordered_map<K, V>& results) {
+        results.insert(row.get<std::pair<K, V>>(0));
+    }
+
+    template <typename K, typename V, typename C>
+    static void get(const Row& row, FlatMap<K, V, C>& results) {
+        results.m_values.push_back(row.get<std::pair<K, V>>(0));
+    }
+
+    static void reserve(Blob&, std::size_t) {}
+
+    template <typename T>
+    static void reserve(T&, std::size_t) {}
+
+    template <typename T>
+    static void reserve(std::vector<T>& results, std::size_t size) {
+        results.reserve(size);
+    }
+
+    template <typename T>
+    static void reserve(std::unordered_set<T>& results, std::size_t size) {
+        results.reserve(size);
+    }
+
+    template <typename K, typename V>
+    static void reserve(std::unordered_map<K, V>& results, std::size_t size) {
+        results.reserve(size);
+    }
+
+    template <typename K, typename V, typename C>
+    static void reserve(FlatMap<K, V, C>& results, std::size_t size) {
+        results.reserve(size);
+    }
+
+    template <typename T>
+    static void finish(T&) {}
+
+    template <typename K, typename V, typename C>
+    static void finish(FlatMap<K, V, C>& results) {
+        results.normalize();
+    }
+
     std::shared_ptr<sqlite3> m_db;
     std::unique_ptr<sqlite3_stmt, void (*)(sqlite3_stmt*)> m_stmt{nullptr, nullptr};
+    std::shared_ptr<Diagnostics> m_diagnostics;
+    std::atomic<std::size_t>* m_executions{nullptr};
+    std::shared_ptr<ResultCache> m_cache;
+    ResultCache::Footprint m_footprint;
+    ColumnConversion m_conversion;
+    bool m_cacheable{false};
+    mutable std::vector<std::string> m_parameters;
 
     bool hasNext() const;
+    ErrorCode lastError() const;
+    void remember(std::size_t index, std::string value) const;
+    std::string cacheKey() const;
+    std::size_t rowBytes() const;
 };
 
 } // namespace sqlite3pp
+
+#ifdef SQLITE3PP_HEADER_ONLY
+#include "StatementInline.hpp"
+#endif
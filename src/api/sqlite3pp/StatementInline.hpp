@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "Error.hpp"
+#include "Statement.hpp"
+
+#include <sqlite3.h>
+
+#include <cstring>
+#include <string>
+
+namespace sqlite3pp {
+
+SQLITE3PP_INLINE ErrorCode Statement::lastError() const {
+    return ErrorCode::fromExtended(sqlite3_extended_errcode(m_db.get()));
+}
+
+SQLITE3PP_INLINE void Statement::bind(std::size_t index, int value) const {
+    if (SQLITE_OK != sqlite3_bind_int(m_stmt.get(), static_cast<int>(index), value)) {
+        throw BindParameterError{sqlite3_errmsg(m_db.get()), index, lastError()};
+    }
+    if (m_cacheable) {
+        remember(index, 'i' + std::to_string(value));
+    }
+}
+
+SQLITE3PP_INLINE void Statement::bind(std::size_t index, double value) const {
+    if (SQLITE_OK != sqlite3_bind_double(m_stmt.get(), static_cast<int>(index), value)) {
+        throw BindParameterError{sqlite3_errmsg(m_db.get()), index, lastError()};
+    }
+    if (m_cacheable) {
+        std::string bits(sizeof(value), '\0');
+        std::memcpy(bits.data(), &value, sizeof(value));
+        remember(index, 'd' + bits);
+    }
+}
+
+SQLITE3PP_INLINE void Statement::bind(std::size_t index, const std::string& value) const {
+    if (SQLITE_OK != sqlite3_bind_text(m_stmt.get(), static_cast<int>(index), value.data(),
+                                       static_cast<int>(value.size()), SQLITE_TRANSIENT)) {
+        throw BindParameterError{sqlite3_errmsg(m_db.get()), index, lastError()};
+    }
+    if (m_cacheable) {
+        remember(index, 't' + value);
+    }
+}
+
+SQLITE3PP_INLINE void Statement::bind(std::size_t index, const Blob& value) const {
+    if (SQLITE_OK != sqlite3_bind_blob(m_stmt.get(), static_cast<int>(index), value.data(),
+                                       static_cast<int>(value.size()), SQLITE_TRANSIENT)) {
+        throw BindParameterError{sqlite3_errmsg(m_db.get()), index, lastError()};
+    }
+    if (m_cacheable) {
+        remember(index, 'b' + std::string{value.begin(), value.end()});
+    }
+}
+
+SQLITE3PP_INLINE Result<bool> Statement::tryStep() const {
+    const auto err = sqlite3_step(m_stmt.get());
+    if (m_cache && !m_cacheable) {
+        m_cache->invalidate(m_footprint);
+    }
+    switch (err) {
+    case SQLITE_ROW:
+        return true;
+    case SQLITE_DONE:
+        // Reset right away, so parameters can be bound for the next execution
+        sqlite3_reset(m_stmt.get());
+        return false;
+    default: {
+        const auto error = lastError();
+        // The error message is kept by the reset, so statement can be reused
+        sqlite3_reset(m_stmt.get());
+        return error;
+    }
+    }
+}
+
+SQLITE3PP_INLINE bool Statement::hasNext() const {
+    const auto next = tryStep();
+    if (!next) {
+        if (SQLITE_INTERRUPT == next.error().code) {
+            throw InterruptedError{next.error()};
+        }
+        throw Error{std::string{"Failed in step: "} + sqlite3_errmsg(m_db.get()), next.error()};
+    }
+    return *next;
+}
+
+} // namespace sqlite3pp
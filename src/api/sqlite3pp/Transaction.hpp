@@ -38,16 +38,20 @@ public:
     Transaction& operator=(Transaction&&) noexcept = default;
     ~Transaction();
 
-    explicit Transaction(std::shared_ptr<sqlite3> db);
+    explicit Transaction(std::shared_ptr<sqlite3> db, std::shared_ptr<Diagnostics> diagnostics = nullptr,
+                         std::shared_ptr<ResultCache> cache = nullptr, Conversion conversion = Conversion::Strict);
 
     void commit() const;
 
-    Statement prepare(const std::string& sql) const { return {m_db, sql}; }
+    Statement prepare(const std::string& sql) const { return {m_db, sql, m_diagnostics, m_cache, m_conversion}; }
 
     void execute(const std::string& sql) const { prepare(sql).execute(); }
 
 private:
     std::shared_ptr<sqlite3> m_db;
+    std::shared_ptr<Diagnostics> m_diagnostics;
+    std::shared_ptr<ResultCache> m_cache;
+    Conversion m_conversion;
 };
 
 } // namespace sqlite3pp
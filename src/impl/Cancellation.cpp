@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <sqlite3.h>
+#include <sqlite3pp/Cancellation.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace sqlite3pp {
+
+namespace {
+
+// Innermost guard of every thread on a connection, as the progress handler
+// runs on the thread stepping the statement. It is always locked after the
+// mutex of the connection, which SQLite holds while calling the handler.
+struct Guards {
+    std::mutex mutex;
+    std::map<std::pair<sqlite3*, std::thread::id>, ExecutionGuard*> innermost;
+};
+
+Guards& guards() {
+    static Guards guards;
+    return guards;
+}
+
+} // namespace
+
+void CancellationToken::cancel() const {
+    m_state->cancelled = true;
+}
+
+ExecutionGuard::ExecutionGuard(sqlite3* db, const ExecutionLimits& limits) : m_db{db}, m_limits{limits} {
+    sqlite3_mutex_enter(sqlite3_db_mutex(m_db));
+    {
+        const std::lock_guard<std::mutex> lock{guards().mutex};
+        auto& innermost = guards().innermost[{m_db, std::this_thread::get_id()}];
+        m_outer = innermost;
+        innermost = this;
+        install(m_db);
+    }
+    sqlite3_mutex_leave(sqlite3_db_mutex(m_db));
+}
+
+ExecutionGuard::~ExecutionGuard() {
+    sqlite3_mutex_enter(sqlite3_db_mutex(m_db));
+    {
+        // Guards of a thread end in reverse order, so this is the innermost
+        const std::lock_guard<std::mutex> lock{guards().mutex};
+        const auto key = std::make_pair(m_db, std::this_thread::get_id());
+        if (nullptr != m_outer) {
+            guards().innermost[key] = m_outer;
+        }
+        else {
+            guards().innermost.erase(key);
+        }
+        install(m_db);
+    }
+    sqlite3_mutex_leave(sqlite3_db_mutex(m_db));
+}
+
+void ExecutionGuard::install(sqlite3* db) {
+    // Checked as often as the guard with the shortest interval requires, and
+    // right at the first instruction, if limits are exceeded already
+    std::optional<int> instructions;
+    auto exceeded = false;
+    for (const auto& [key, innermost] : guards().innermost) {
+        if (key.first != db) {
+            continue;
+        }
+        for (const auto* guard = innermost; nullptr != guard; guard = guard->m_outer) {
+            instructions = std::min(instructions.value_or(guard->m_limits.instructions), guard->m_limits.instructions);
+            exceeded = exceeded || guard->isExceeded();
+        }
+    }
+    if (instructions) {
+        sqlite3_progress_handler(db, exceeded ? 1 : *instructions, &onProgress, db);
+    }
+    else {
+        sqlite3_progress_handler(db, 0, nullptr, nullptr);
+    }
+}
+
+bool ExecutionGuard::isExceeded() const {
+    if (m_limits.token && m_limits.token->isCancelled()) {
+        return true;
+    }
+    return m_limits.deadline && std::chrono::steady_clock::now() >= *m_limits.deadline;
+}
+
+int ExecutionGuard::onProgress(void* db) {
+    const std::lock_guard<std::mutex> lock{guards().mutex};
+    // Only limits of the thread stepping the statement apply
+    const auto it = guards().innermost.find({static_cast<sqlite3*>(db), std::this_thread::get_id()});
+    if (guards().innermost.end() == it) {
+        return 0;
+    }
+    for (const auto* guard = it->second; nullptr != guard; guard = guard->m_outer) {
+        if (guard->isExceeded()) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace sqlite3pp
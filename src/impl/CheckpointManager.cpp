@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <sqlite3.h>
+#include <sqlite3pp/CheckpointManager.hpp>
+#include <sqlite3pp/Error.hpp>
+
+#include <set>
+
+namespace sqlite3pp {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Connections with a manager, as each one replaces the WAL hook of the other
+std::mutex managedMutex;
+std::set<sqlite3*> managed;
+
+int autoCheckpoint(sqlite3* db) {
+    sqlite3_stmt* stmt{nullptr};
+    auto pages = 0;
+    if (SQLITE_OK == sqlite3_prepare_v2(db, "PRAGMA wal_autocheckpoint", -1, &stmt, nullptr) &&
+        SQLITE_ROW == sqlite3_step(stmt)) {
+        pages = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return pages;
+}
+
+} // namespace
+
+CheckpointManager::CheckpointManager(std::shared_ptr<sqlite3> db, const CheckpointPolicy& policy)
+: m_db{std::move(db)}, m_policy{policy}, m_lastCommit{Clock::now()} {
+    const auto* fileName = sqlite3_db_filename(m_db.get(), "main");
+    if (nullptr == fileName || '\0' == *fileName) {
+        throw Error{"Checkpoints require a database file"};
+    }
+    sqlite3* checkpointDb{nullptr};
+    const auto err = sqlite3_open_v2(fileName, &checkpointDb, SQLITE_OPEN_READWRITE, nullptr);
+    m_checkpointDb = {checkpointDb, sqlite3_close_v2};
+    if (SQLITE_OK != err) {
+        throw OpenDatabaseError{fileName, sqlite3_errmsg(checkpointDb),
+                                ErrorCode::fromExtended(sqlite3_extended_errcode(checkpointDb))};
+    }
+    // Checkpoints are no-ops, until the connection has read the database and
+    // thereby opened the WAL
+    sqlite3_exec(checkpointDb, "PRAGMA schema_version", nullptr, nullptr, nullptr);
+    {
+        const std::lock_guard<std::mutex> lock{managedMutex};
+        if (!managed.insert(m_db.get()).second) {
+            throw Error{"Connection has a checkpoint manager already"};
+        }
+    }
+    // Restored when the manager is gone, as it may differ from the default
+    m_autoCheckpoint = autoCheckpoint(m_db.get());
+    // Auto-checkpointing is implemented by the WAL hook, so replacing the hook
+    // disables it
+    sqlite3_wal_hook(m_db.get(), &onCommit, this);
+    m_thread = std::thread{[this] { run(); }};
+}
+
+CheckpointManager::~CheckpointManager() {
+    {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+    sqlite3_wal_autocheckpoint(m_db.get(), m_autoCheckpoint);
+    const std::lock_guard<std::mutex> lock{managedMutex};
+    managed.erase(m_db.get());
+}
+
+CheckpointStatistics CheckpointManager::statistics() const {
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    return m_statistics;
+}
+
+int CheckpointManager::onCommit(void* self, sqlite3* /*db*/, const char* /*database*/, int frames) {
+    auto* manager = static_cast<CheckpointManager*>(self);
+    bool due{false};
+    {
+        const std::lock_guard<std::mutex> lock{manager->m_mutex};
+        manager->m_statistics.walFrames = static_cast<std::size_t>(frames);
+        manager->m_lastCommit = Clock::now();
+        // The WAL was restarted from the beginning
+        if (manager->m_statistics.walFrames < manager->m_checkpointed) {
+            manager->m_checkpointed = 0;
+        }
+        due = manager->m_statistics.walFrames >= manager->m_checkpointed + manager->m_policy.frames;
+        manager->m_due = manager->m_due || due;
+    }
+    if (due) {
+        manager->m_wakeup.notify_one();
+    }
+    return SQLITE_OK;
+}
+
+void CheckpointManager::run() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (!m_stop) {
+        m_wakeup.wait_for(lock, m_policy.interval, [this] { return m_stop || m_due; });
+        if (m_stop) {
+            break;
+        }
+        m_due = false;
+        if (Clock::now() - m_lastCommit >= m_policy.idle) {
+            if (0 < m_statistics.walFrames) {
+                checkpoint(true, lock);
+            }
+        }
+        else if (m_statistics.walFrames > m_checkpointed) {
+            checkpoint(false, lock);
+        }
+    }
+}
+
+void CheckpointManager::checkpoint(bool truncate, std::unique_lock<std::mutex>& lock) {
+    lock.unlock();
+    int log{0};
+    int checkpointed{0};
+    const auto mode = truncate ? SQLITE_CHECKPOINT_TRUNCATE : SQLITE_CHECKPOINT_PASSIVE;
+    const auto start = Clock::now();
+    const auto err = sqlite3_wal_checkpoint_v2(m_checkpointDb.get(), nullptr, mode, &log, &checkpointed);
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+    lock.lock();
+    // Busy database is retried on the next occasion
+    if (SQLITE_OK != err || 0 > log) {
+        return;
+    }
+    // A truncated WAL reports no frames at all, so count the ones seen before
+    const auto total = truncate ? m_statistics.walFrames : static_cast<std::size_t>(checkpointed);
+    m_statistics.framesCheckpointed += total >= m_checkpointed ? total - m_checkpointed : total;
+    m_statistics.walFrames = truncate ? 0 : static_cast<std::size_t>(log);
+    m_checkpointed = truncate ? 0 : static_cast<std::size_t>(checkpointed);
+    m_statistics.truncations += truncate ? 1 : 0;
+    ++m_statistics.checkpoints;
+    m_statistics.lastDuration = duration;
+    m_statistics.totalDuration += duration;
+}
+
+} // namespace sqlite3pp
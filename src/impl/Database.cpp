@@ -25,8 +25,30 @@
 #include <sqlite3pp/Database.hpp>
 #include <sqlite3pp/Error.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace sqlite3pp {
 
+namespace {
+
+// Images of WAL databases are turned into rollback mode, as in-memory
+// databases cannot have a WAL. Bytes 18 and 19 are the file format versions.
+void toRollbackMode(unsigned char* header, std::size_t size) {
+    if (20 <= size && 2 == header[18]) { // NOLINT: bridge to C-code
+        header[18] = header[19] = 1;    // NOLINT: bridge to C-code
+    }
+}
+
+} // namespace
+
 Database::Database(const std::string& uri) {
 
     sqlite3* db{nullptr};
@@ -37,8 +59,104 @@ Database::Database(const std::string& uri) {
     // good. That's why we first initialize the shared_ptr and then check for error
     m_db = std::shared_ptr<sqlite3>{db, [](auto* db) { sqlite3_close_v2(db); }};
     if (SQLITE_OK != err) {
-        throw OpenDatabaseError{uri, sqlite3_errmsg(db)};
+        throw OpenDatabaseError{uri, sqlite3_errmsg(db), ErrorCode::fromExtended(sqlite3_extended_errcode(db))};
+    }
+}
+
+Database Database::fromImage(const Blob& image) {
+    auto* data = static_cast<unsigned char*>(sqlite3_malloc64(std::max<std::size_t>(image.size(), 1)));
+    if (nullptr == data) {
+        throw std::bad_alloc{};
+    }
+    std::copy(image.begin(), image.end(), data);
+    toRollbackMode(data, image.size());
+    const auto flags = SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_RESIZEABLE;
+    return fromMemory(data, image.size(), flags, nullptr);
+}
+
+Database Database::fromImage(const std::filesystem::path& fileName, bool map) {
+    std::error_code error;
+    const auto size = std::filesystem::file_size(fileName, error);
+    if (error) {
+        throw OpenDatabaseError{fileName.string(), error.message()};
+    }
+#ifndef _WIN32
+    if (map && 0 < size) {
+        const auto file = ::open(fileName.c_str(), O_RDONLY); // NOLINT: bridge to C-code
+        if (0 > file) {
+            throw OpenDatabaseError{fileName.string(), "Failed to open file"};
+        }
+        // Private mapping copies only the header page, when it is patched
+        auto* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if (MAP_FAILED == address) { // NOLINT: bridge to C-code
+            throw OpenDatabaseError{fileName.string(), "Failed to map file"};
+        }
+        auto memory = std::shared_ptr<void>{address, [size](auto* address) { ::munmap(address, size); }};
+        toRollbackMode(static_cast<unsigned char*>(address), size);
+        return fromMemory(static_cast<unsigned char*>(address), size, SQLITE_DESERIALIZE_READONLY, std::move(memory));
+    }
+#endif
+    // Without memory mapping the file is copied, but read-only nevertheless
+    auto* data = static_cast<unsigned char*>(sqlite3_malloc64(std::max<std::uintmax_t>(size, 1)));
+    if (nullptr == data) {
+        throw std::bad_alloc{};
+    }
+    std::ifstream file{fileName, std::ios::binary};
+    file.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size)); // NOLINT: bridge to C-code
+    if (!file) {
+        sqlite3_free(data);
+        throw OpenDatabaseError{fileName.string(), "Failed to read file"};
+    }
+    toRollbackMode(data, size);
+    const auto access = map ? SQLITE_DESERIALIZE_READONLY : SQLITE_DESERIALIZE_RESIZEABLE;
+    const auto flags = SQLITE_DESERIALIZE_FREEONCLOSE | access;
+    return fromMemory(data, size, flags, nullptr);
+}
+
+Database Database::fromMemory(unsigned char* data, std::size_t size, unsigned int flags,
+                              std::shared_ptr<void> memory) {
+    sqlite3* db{nullptr};
+    const auto err = sqlite3_open_v2(":memory:", &db, SQLITE_OPEN_READWRITE, nullptr);
+    // Memory passed to the database must outlive it
+    auto result = Database{std::shared_ptr<sqlite3>{db, [memory = std::move(memory)](auto* db) mutable {
+                               sqlite3_close_v2(db);
+                               memory.reset();
+                           }}};
+    if (SQLITE_OK != err) {
+        if (0 != (flags & SQLITE_DESERIALIZE_FREEONCLOSE)) {
+            sqlite3_free(data);
+        }
+        throw OpenDatabaseError{":memory:", sqlite3_errmsg(db), ErrorCode::fromExtended(sqlite3_extended_errcode(db))};
+    }
+    const auto length = static_cast<sqlite3_int64>(size);
+    // On failure SQLite releases the memory on its own, if it owns it
+    if (SQLITE_OK != sqlite3_deserialize(db, "main", data, length, length, flags)) {
+        throw OpenDatabaseError{":memory:", sqlite3_errmsg(db), ErrorCode::fromExtended(sqlite3_extended_errcode(db))};
+    }
+    return result;
+}
+
+Blob Database::serialize(const std::string& database) const {
+    sqlite3_int64 size{0};
+    // Deserialized databases expose their memory directly, others are copied
+    if (const auto* data = sqlite3_serialize(m_db.get(), database.c_str(), &size, SQLITE_SERIALIZE_NOCOPY)) {
+        auto image = Blob(data, data + size); // NOLINT: bridge to C-code
+        toRollbackMode(image.data(), image.size());
+        return image;
+    }
+    auto* data = sqlite3_serialize(m_db.get(), database.c_str(), &size, 0);
+    const auto release = std::unique_ptr<unsigned char, void (*)(void*)>{data, sqlite3_free};
+    if (nullptr == data) {
+        // Empty databases have no pages, so there is nothing to allocate
+        if (0 == size) {
+            return {};
+        }
+        throw Error{"Failed to serialize database: " + database};
     }
+    auto image = Blob(data, data + size); // NOLINT: bridge to C-code
+    toRollbackMode(image.data(), image.size());
+    return image;
 }
 
 } // namespace sqlite3pp
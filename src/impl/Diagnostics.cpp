@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <sqlite3pp/Diagnostics.hpp>
+#include <sqlite3pp/Statement.hpp>
+
+#include <set>
+
+namespace sqlite3pp {
+
+namespace {
+
+bool contains(const std::string& text, const char* pattern) { return std::string::npos != text.find(pattern); }
+
+bool startsWith(const std::string& text, const char* pattern) { return 0 == text.rfind(pattern, 0); }
+
+// Name following the given prefix, up to the next blank
+std::string nameAfter(const std::string& detail, const char* prefix) {
+    const auto begin = std::char_traits<char>::length(prefix);
+    return detail.substr(begin, detail.find(' ', begin) - begin);
+}
+
+// Collects names of CTEs and subqueries, which are materialized or run as co-routines
+void collectSubqueries(const QueryPlan& node, std::set<std::string>& names) {
+    if (startsWith(node.detail, "MATERIALIZE ")) {
+        names.insert(nameAfter(node.detail, "MATERIALIZE "));
+    } else if (startsWith(node.detail, "CO-ROUTINE ")) {
+        names.insert(nameAfter(node.detail, "CO-ROUTINE "));
+    }
+    for (const auto& child : node.children) {
+        collectSubqueries(child, names);
+    }
+}
+
+// Scans of subqueries and CTEs only iterate over their (already planned) results
+bool isTableScan(const std::string& detail, const std::set<std::string>& subqueries) {
+    if (!startsWith(detail, "SCAN ") || startsWith(detail, "SCAN (") || startsWith(detail, "SCAN SUBQUERY ")) {
+        return false;
+    }
+    return !contains(detail, " USING ") && !contains(detail, "CONSTANT ROW") && !contains(detail, "VALUES CLAUSE") &&
+           !contains(detail, "VIRTUAL TABLE") && 0 == subqueries.count(nameAfter(detail, "SCAN "));
+}
+
+void collectWarnings(const QueryPlan& node, const std::set<std::string>& subqueries,
+                     std::vector<PlanWarning>& warnings) {
+    const auto& detail = node.detail;
+    if (isTableScan(detail, subqueries)) {
+        warnings.push_back({PlanWarning::Kind::FullScan, detail});
+    }
+    if (contains(detail, "USE TEMP B-TREE")) {
+        warnings.push_back({PlanWarning::Kind::TempBTree, detail});
+    }
+    if (contains(detail, "AUTOMATIC")) {
+        warnings.push_back({PlanWarning::Kind::AutomaticIndex, detail});
+    }
+    for (const auto& child : node.children) {
+        collectWarnings(child, subqueries, warnings);
+    }
+}
+
+} // namespace
+
+std::vector<PlanWarning> Diagnostics::analyze(const QueryPlan& plan) {
+    std::set<std::string> subqueries;
+    collectSubqueries(plan, subqueries);
+    std::vector<PlanWarning> warnings;
+    collectWarnings(plan, subqueries, warnings);
+    return warnings;
+}
+
+std::atomic<std::size_t>& Diagnostics::track(const Statement& stmt, const std::string& sql) {
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_entries.find(sql);
+    if (m_entries.end() == it) {
+        auto plan = stmt.queryPlan();
+        auto warnings = analyze(plan);
+        it = m_entries.try_emplace(sql).first;
+        it->second.plan = std::move(plan);
+        it->second.warnings = std::move(warnings);
+    }
+    return it->second.executions;
+}
+
+void Diagnostics::report() const {
+    // Handler is called without the lock, so it can use the same database
+    std::vector<StatementDiagnostics> reports;
+    {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        for (const auto& [sql, entry] : m_entries) {
+            if (!entry.warnings.empty()) {
+                reports.push_back({sql, entry.plan, entry.warnings, entry.executions.load()});
+            }
+        }
+    }
+    for (const auto& report : reports) {
+        m_handler(report);
+    }
+}
+
+} // namespace sqlite3pp
@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <sqlite3.h>
+#include <sqlite3pp/ResultCache.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace sqlite3pp {
+
+namespace {
+
+// Rough per entry bookkeeping overhead (list node, index node, key)
+constexpr std::size_t entryOverhead = 128;
+
+std::string qualify(const char* database, const char* table) {
+    return std::string{nullptr != database ? database : "main"} + '.' + table;
+}
+
+// Built-in functions, whose results differ between executions. Date and time
+// functions are only volatile for 'now', but their arguments are not known.
+bool isNondeterministic(const char* function) {
+    static const std::set<std::string> functions{
+        "random",    "randomblob", "changes",   "total_changes", "last_insert_rowid", "date",         "time",
+        "datetime",  "julianday",  "strftime",  "unixepoch",     "timediff",          "current_date", "current_time",
+        "current_timestamp"};
+    std::string name{function};
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    return 0 != functions.count(name);
+}
+
+} // namespace
+
+ResultCache::ResultCache(std::shared_ptr<sqlite3> db, std::size_t capacity)
+: m_db{std::move(db)}, m_capacity{capacity} {
+    // Only one cache can observe a connection, the previous one stops caching
+    auto* previous = static_cast<ResultCache*>(sqlite3_update_hook(m_db.get(), &onUpdate, this));
+    if (nullptr != previous) {
+        previous->detach();
+    }
+    sqlite3_commit_hook(m_db.get(), &onCommit, this);
+    sqlite3_rollback_hook(m_db.get(), &onRollback, this);
+    sqlite3_set_authorizer(m_db.get(), &onAuthorize, this);
+}
+
+ResultCache::~ResultCache() {
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_attached) {
+        sqlite3_update_hook(m_db.get(), nullptr, nullptr);
+        sqlite3_commit_hook(m_db.get(), nullptr, nullptr);
+        sqlite3_rollback_hook(m_db.get(), nullptr, nullptr);
+        sqlite3_set_authorizer(m_db.get(), nullptr, nullptr);
+    }
+}
+
+ResultCache::Footprint ResultCache::collect(const std::function<void()>& prepare) {
+    const std::lock_guard<std::mutex> prepareLock{m_prepareMutex};
+    Names names;
+    m_names = &names;
+    try {
+        prepare();
+    }
+    catch (...) {
+        m_names = nullptr;
+        throw;
+    }
+    m_names = nullptr;
+
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    Footprint footprint{{}, {}, names.schemaChange, names.rollback, names.nondeterministic};
+    for (const auto& table : names.reads) {
+        footprint.reads.push_back(version(table));
+    }
+    for (const auto& table : names.writes) {
+        footprint.writes.push_back(version(table));
+    }
+    return footprint;
+}
+
+std::optional<std::any> ResultCache::find(const std::string& key, std::type_index type) {
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    const auto it = m_index.find(Key{key, type});
+    if (m_index.end() == it) {
+        ++m_statistics.misses;
+        return std::nullopt;
+    }
+    const auto entry = it->second;
+    const auto valid = [this](const Entry& entry) {
+        if (entry.epoch != m_epoch) {
+            return false;
+        }
+        for (const auto& [version, value] : entry.versions) {
+            if (*version != value) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!valid(*entry)) {
+        evict(entry);
+        ++m_statistics.misses;
+        return std::nullopt;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+    ++m_statistics.hits;
+    return entry->value;
+}
+
+void ResultCache::insert(const std::string& key, std::type_index type, const Footprint& footprint, std::any value,
+                         std::size_t bytes) {
+    bytes += key.size() + entryOverhead;
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    if (!m_attached || bytes > m_capacity) {
+        return;
+    }
+    const auto existing = m_index.find(Key{key, type});
+    if (m_index.end() != existing) {
+        evict(existing->second);
+    }
+    while (m_statistics.bytes + bytes > m_capacity) {
+        evict(std::prev(m_entries.end()));
+    }
+    Entry entry{Key{key, type}, std::move(value), bytes, m_epoch, {}};
+    for (const auto* version : footprint.reads) {
+        entry.versions.emplace_back(version, *version);
+    }
+    m_entries.push_front(std::move(entry));
+    m_index.emplace(m_entries.front().key, m_entries.begin());
+    m_statistics.bytes += bytes;
+    ++m_statistics.entries;
+}
+
+void ResultCache::invalidate(const Footprint& footprint) {
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    const auto inTransaction = 0 == sqlite3_get_autocommit(m_db.get());
+    for (auto* version : footprint.writes) {
+        ++*version;
+        if (inTransaction) {
+            m_dirty.insert(version);
+        }
+    }
+    if (footprint.rollback) {
+        // ROLLBACK TO does not trigger the rollback hook
+        for (auto* version : m_dirty) {
+            ++*version;
+        }
+    }
+    if (footprint.schemaChange) {
+        ++m_epoch;
+    }
+}
+
+ResultCache::Statistics ResultCache::statistics() const {
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    return m_statistics;
+}
+
+int ResultCache::onAuthorize(void* self, int action, const char* arg1, const char* arg2, const char* database,
+                             const char* /*trigger*/) {
+    auto* names = static_cast<ResultCache*>(self)->m_names;
+    if (nullptr == names) {
+        return SQLITE_OK;
+    }
+    switch (action) {
+    case SQLITE_READ:
+        names->reads.insert(qualify(database, arg1));
+        // Internal tables like sqlite_sequence change without the update hook
+        names->nondeterministic = names->nondeterministic || 0 == std::strncmp(arg1, "sqlite_", 7);
+        break;
+    case SQLITE_INSERT:
+    case SQLITE_UPDATE:
+    case SQLITE_DELETE:
+        names->writes.insert(qualify(database, arg1));
+        break;
+    case SQLITE_DROP_TABLE:
+    case SQLITE_DROP_TEMP_TABLE:
+    case SQLITE_DROP_VIEW:
+    case SQLITE_DROP_TEMP_VIEW:
+    case SQLITE_DROP_VTABLE:
+    case SQLITE_ALTER_TABLE:
+    case SQLITE_ATTACH:
+    case SQLITE_DETACH:
+        names->schemaChange = true;
+        break;
+    case SQLITE_SAVEPOINT:
+        names->rollback = names->rollback || 0 == std::strcmp(arg1, "ROLLBACK");
+        break;
+    case SQLITE_FUNCTION:
+        names->nondeterministic = names->nondeterministic || isNondeterministic(arg2);
+        break;
+    default:
+        break;
+    }
+    return SQLITE_OK;
+}
+
+void ResultCache::onUpdate(void* self, int /*operation*/, const char* database, const char* table,
+                           long long /*rowid*/) {
+    auto* cache = static_cast<ResultCache*>(self);
+    const std::lock_guard<std::mutex> lock{cache->m_mutex};
+    auto* version = cache->version(qualify(database, table));
+    ++*version;
+    cache->m_dirty.insert(version);
+}
+
+int ResultCache::onCommit(void* self) {
+    auto* cache = static_cast<ResultCache*>(self);
+    const std::lock_guard<std::mutex> lock{cache->m_mutex};
+    cache->m_dirty.clear();
+    return 0;
+}
+
+void ResultCache::onRollback(void* self) {
+    auto* cache = static_cast<ResultCache*>(self);
+    const std::lock_guard<std::mutex> lock{cache->m_mutex};
+    for (auto* version : cache->m_dirty) {
+        ++*version;
+    }
+    cache->m_dirty.clear();
+}
+
+std::uint64_t* ResultCache::version(const std::string& table) { return &m_versions[table]; }
+
+void ResultCache::evict(std::list<Entry>::iterator entry) {
+    m_statistics.bytes -= entry->bytes;
+    --m_statistics.entries;
+    m_index.erase(entry->key);
+    m_entries.erase(entry);
+}
+
+void ResultCache::detach() {
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    m_attached = false;
+    m_index.clear();
+    m_entries.clear();
+    m_statistics.bytes = 0;
+    m_statistics.entries = 0;
+}
+
+} // namespace sqlite3pp
@@ -21,46 +21,4 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
-#include <sqlite3.h>
-#include <sqlite3pp/Error.hpp>
-#include <sqlite3pp/Row.hpp>
-
-namespace sqlite3pp {
-
-std::size_t Row::get(std::size_t index, int& value) const {
-    if (SQLITE_INTEGER != sqlite3_column_type(m_stmt, static_cast<int>(index))) {
-        throw TypeMismatchError{index};
-    }
-    value = sqlite3_column_int(m_stmt, static_cast<int>(index));
-    return index + 1;
-}
-
-std::size_t Row::get(std::size_t index, double& value) const {
-    if (SQLITE_FLOAT != sqlite3_column_type(m_stmt, static_cast<int>(index))) {
-        throw TypeMismatchError{index};
-    }
-    value = sqlite3_column_double(m_stmt, static_cast<int>(index));
-    return index + 1;
-}
-
-std::size_t Row::get(std::size_t index, std::string& value) const {
-    if (SQLITE_TEXT != sqlite3_column_type(m_stmt, static_cast<int>(index))) {
-        throw TypeMismatchError{index};
-    }
-    const auto* text = sqlite3_column_text(m_stmt, static_cast<int>(index));
-    const auto length = sqlite3_column_bytes(m_stmt, static_cast<int>(index));
-    value.assign(text, text + length); // NOLINT: bridge to C-code
-    return index + 1;
-}
-
-std::size_t Row::get(std::size_t index, Blob& value) const {
-    if (SQLITE_BLOB != sqlite3_column_type(m_stmt, static_cast<int>(index))) {
-        throw TypeMismatchError{index};
-    }
-    const auto* data = static_cast<Blob::const_pointer>(sqlite3_column_blob(m_stmt, static_cast<int>(index)));
-    const auto length = sqlite3_column_bytes(m_stmt, static_cast<int>(index));
-    value.assign(data, data + length); // NOLINT: bridge to C-code
-    return index + 1;
-}
-
-} // namespace sqlite3pp
+#include <sqlite3pp/RowInline.hpp>
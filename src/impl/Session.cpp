@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifdef SQLITE_ENABLE_SESSION
+
+#include <sqlite3.h>
+#include <sqlite3pp/Error.hpp>
+#include <sqlite3pp/Session.hpp>
+
+#include <exception>
+
+namespace sqlite3pp {
+
+namespace {
+
+void check(int err) {
+    if (SQLITE_OK != err) {
+        throw SessionError{sqlite3_errstr(err), ErrorCode::fromExtended(err)};
+    }
+}
+
+Blob extract(int (*extractor)(sqlite3_session*, int*, void**), sqlite3_session* session) {
+    int size{0};
+    void* data{nullptr};
+    const auto err = extractor(session, &size, &data);
+    const auto release = std::unique_ptr<void, void (*)(void*)>{data, sqlite3_free};
+    check(err);
+    const auto* bytes = static_cast<Blob::const_pointer>(data);
+    return Blob(bytes, bytes + size); // NOLINT: bridge to C-code
+}
+
+struct ApplyContext {
+    const Session::ConflictHandler& handler;
+    std::exception_ptr error;
+};
+
+Conflict::Type conflictType(int type) {
+    switch (type) {
+    case SQLITE_CHANGESET_DATA:
+        return Conflict::Type::Data;
+    case SQLITE_CHANGESET_NOTFOUND:
+        return Conflict::Type::NotFound;
+    case SQLITE_CHANGESET_CONFLICT:
+        return Conflict::Type::Conflict;
+    case SQLITE_CHANGESET_CONSTRAINT:
+        return Conflict::Type::Constraint;
+    default:
+        return Conflict::Type::ForeignKey;
+    }
+}
+
+Conflict::Operation conflictOperation(int operation) {
+    switch (operation) {
+    case SQLITE_INSERT:
+        return Conflict::Operation::Insert;
+    case SQLITE_UPDATE:
+        return Conflict::Operation::Update;
+    default:
+        return Conflict::Operation::Delete;
+    }
+}
+
+int onConflict(void* ctx, int type, sqlite3_changeset_iter* iter) {
+    auto* context = static_cast<ApplyContext*>(ctx);
+    if (!context->handler || context->error) {
+        return SQLITE_CHANGESET_ABORT;
+    }
+    try {
+        const char* table{nullptr};
+        int columns{0};
+        int operation{0};
+        int indirect{0};
+        check(sqlite3changeset_op(iter, &table, &columns, &operation, &indirect));
+        switch (context->handler({conflictType(type), conflictOperation(operation), table})) {
+        case ConflictAction::Omit:
+            return SQLITE_CHANGESET_OMIT;
+        case ConflictAction::Replace:
+            return SQLITE_CHANGESET_REPLACE;
+        default:
+            return SQLITE_CHANGESET_ABORT;
+        }
+    }
+    catch (...) {
+        // Exceptions must not pass the C-code, rethrow them after abort
+        context->error = std::current_exception();
+        return SQLITE_CHANGESET_ABORT;
+    }
+}
+
+} // namespace
+
+Session::Session(std::shared_ptr<sqlite3> db, const std::string& database) : m_db{std::move(db)} {
+    sqlite3_session* session{nullptr};
+    const auto err = sqlite3session_create(m_db.get(), database.c_str(), &session);
+    m_session = {session, sqlite3session_delete};
+    check(err);
+}
+
+void Session::attach(const std::string& table) const { check(sqlite3session_attach(m_session.get(), table.c_str())); }
+
+void Session::attach() const { check(sqlite3session_attach(m_session.get(), nullptr)); }
+
+bool Session::isEmpty() const { return 0 != sqlite3session_isempty(m_session.get()); }
+
+Blob Session::changeset() const { return extract(sqlite3session_changeset, m_session.get()); }
+
+Blob Session::patchset() const { return extract(sqlite3session_patchset, m_session.get()); }
+
+void Session::apply(const std::shared_ptr<sqlite3>& db, const Blob& changeset, const ConflictHandler& handler) {
+    ApplyContext context{handler, nullptr};
+    // sqlite3changeset_apply does not modify the changeset, it is just not declared const
+    auto* data = const_cast<Blob::pointer>(changeset.data()); // NOLINT: bridge to C-code
+    const auto err = sqlite3changeset_apply(db.get(), static_cast<int>(changeset.size()), data, nullptr,
+                                            &onConflict, &context);
+    if (context.error) {
+        std::rethrow_exception(context.error);
+    }
+    if (SQLITE_OK != err) {
+        throw SessionError{sqlite3_errmsg(db.get()), ErrorCode::fromExtended(sqlite3_extended_errcode(db.get()))};
+    }
+}
+
+} // namespace sqlite3pp
+
+#endif // SQLITE_ENABLE_SESSION
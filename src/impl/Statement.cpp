@@ -22,55 +22,125 @@
  * SOFTWARE.
  */
 #include <sqlite3.h>
+#include <sqlite3pp/Diagnostics.hpp>
 #include <sqlite3pp/Error.hpp>
 #include <sqlite3pp/Statement.hpp>
+#include <sqlite3pp/StatementInline.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <tuple>
+#include <vector>
 
 namespace sqlite3pp {
 
-Statement::Statement(std::shared_ptr<sqlite3> db, const std::string& sql) : m_db{std::move(db)} {
+namespace {
+
+// Follows the affinity rules of SQLite, expressions have no affinity at all
+bool hasNumericAffinity(const char* declared) {
+    if (nullptr == declared) {
+        return false;
+    }
+    std::string type{declared};
+    std::transform(type.begin(), type.end(), type.begin(), [](unsigned char c) { return std::toupper(c); });
+    const auto contains = [&type](const char* name) { return std::string::npos != type.find(name); };
+    if (contains("INT")) {
+        return true;
+    }
+    return !type.empty() && !contains("CHAR") && !contains("CLOB") && !contains("TEXT") && !contains("BLOB");
+}
+
+} // namespace
+
+Statement::Statement(std::shared_ptr<sqlite3> db, const std::string& sql, std::shared_ptr<Diagnostics> diagnostics,
+                     std::shared_ptr<ResultCache> cache, Conversion conversion)
+: m_db{std::move(db)}, m_diagnostics{std::move(diagnostics)}, m_cache{std::move(cache)}, m_conversion{conversion, {}} {
     sqlite3_stmt* stmt{nullptr};
-    const auto err = sqlite3_prepare_v2(m_db.get(), sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr);
+    auto err = SQLITE_OK;
+    const auto prepare = [&] {
+        err = sqlite3_prepare_v2(m_db.get(), sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr);
+    };
+    if (m_cache) {
+        m_footprint = m_cache->collect(prepare);
+    }
+    else {
+        prepare();
+    }
     m_stmt = {stmt, [](auto* stmt) { sqlite3_finalize(stmt); }};
     if (SQLITE_OK != err) {
-        throw PrepareStatementError{sqlite3_errmsg(m_db.get()), sql};
+        throw PrepareStatementError{sqlite3_errmsg(m_db.get()), sql, lastError()};
     }
-}
-
-void Statement::bind(std::size_t index, int value) const {
-    if (SQLITE_OK != sqlite3_bind_int(m_stmt.get(), static_cast<int>(index), value)) {
-        throw BindParameterError{sqlite3_errmsg(m_db.get()), index};
+    if (m_diagnostics && m_stmt) {
+        m_executions = &m_diagnostics->track(*this, sql);
+    }
+    m_cacheable = m_cache && m_stmt && 0 != sqlite3_stmt_readonly(m_stmt.get()) && !m_footprint.reads.empty() &&
+                  m_footprint.writes.empty() && !m_footprint.nondeterministic;
+    const auto columns = sqlite3_column_count(m_stmt.get());
+    for (auto column = 0; column < columns; ++column) {
+        m_conversion.numericAffinity.push_back(hasNumericAffinity(sqlite3_column_decltype(m_stmt.get(), column)));
     }
 }
 
-void Statement::bind(std::size_t index, double value) const {
-    if (SQLITE_OK != sqlite3_bind_double(m_stmt.get(), static_cast<int>(index), value)) {
-        throw BindParameterError{sqlite3_errmsg(m_db.get()), index};
+QueryPlan Statement::queryPlan() const {
+    QueryPlan plan;
+    // EXPLAIN statements cannot be explained again
+    if (!m_stmt || 0 != sqlite3_stmt_isexplain(m_stmt.get())) {
+        return plan;
     }
+    using Step = std::tuple<int, int, std::string>;
+    std::vector<Step> steps;
+    Statement{m_db, std::string{"EXPLAIN QUERY PLAN "} + sqlite3_sql(m_stmt.get())}.execute([&steps](const Row& row) {
+        steps.emplace_back(row.get<int>(0), row.get<int>(1), row.get<std::string>(3));
+    });
+    // Steps are reported in depth-first order, each one referring to its parent
+    const std::function<void(QueryPlan&)> attachChildren = [&](QueryPlan& node) {
+        for (const auto& [id, parent, detail] : steps) {
+            if (parent == node.id) {
+                attachChildren(node.children.emplace_back(QueryPlan{id, detail, {}}));
+            }
+        }
+    };
+    attachChildren(plan);
+    return plan;
 }
 
-void Statement::bind(std::size_t index, const std::string& value) const {
-    if (SQLITE_OK != sqlite3_bind_text(m_stmt.get(), static_cast<int>(index), value.data(),
-                                       static_cast<int>(value.size()), SQLITE_TRANSIENT)) {
-        throw BindParameterError{sqlite3_errmsg(m_db.get()), index};
+void Statement::remember(std::size_t index, std::string value) const {
+    if (m_parameters.size() < index) {
+        m_parameters.resize(index);
     }
+    m_parameters[index - 1] = std::move(value);
 }
 
-void Statement::bind(std::size_t index, const Blob& value) const {
-    if (SQLITE_OK != sqlite3_bind_blob(m_stmt.get(), static_cast<int>(index), value.data(),
-                                       static_cast<int>(value.size()), SQLITE_TRANSIENT)) {
-        throw BindParameterError{sqlite3_errmsg(m_db.get()), index};
+std::string Statement::cacheKey() const {
+    // Parameters are length prefixed to keep the key unambiguous, the policy
+    // is part of it, as it decides which values can be extracted
+    std::string key{Conversion::Strict == m_conversion.policy ? 's' : 'a'};
+    key += sqlite3_sql(m_stmt.get());
+    for (const auto& parameter : m_parameters) {
+        key += '\0' + std::to_string(parameter.size()) + ':' + parameter;
     }
+    return key;
 }
 
-bool Statement::hasNext() const {
-    switch (sqlite3_step(m_stmt.get())) {
-    case SQLITE_DONE:
-        return false;
-    case SQLITE_ROW:
-        return true;
-    default:
-        throw Error{"Failed in step"};
+std::size_t Statement::rowBytes() const {
+    std::size_t bytes{0};
+    const auto columns = sqlite3_column_count(m_stmt.get());
+    for (auto column = 0; column < columns; ++column) {
+        switch (sqlite3_column_type(m_stmt.get(), column)) {
+        case SQLITE_INTEGER:
+        case SQLITE_FLOAT:
+            bytes += sizeof(double);
+            break;
+        case SQLITE_TEXT:
+        case SQLITE_BLOB:
+            bytes += static_cast<std::size_t>(sqlite3_column_bytes(m_stmt.get(), column));
+            break;
+        default:
+            break;
+        }
     }
+    return bytes;
 }
 
 } // namespace sqlite3pp
@@ -26,7 +26,11 @@
 
 namespace sqlite3pp {
 
-Transaction::Transaction(std::shared_ptr<sqlite3> db) : m_db(std::move(db)) { execute("BEGIN"); }
+Transaction::Transaction(std::shared_ptr<sqlite3> db, std::shared_ptr<Diagnostics> diagnostics,
+                         std::shared_ptr<ResultCache> cache, Conversion conversion)
+: m_db(std::move(db)), m_diagnostics(std::move(diagnostics)), m_cache(std::move(cache)), m_conversion(conversion) {
+    execute("BEGIN");
+}
 
 Transaction::~Transaction() { execute("ROLLBACK"); }
 
@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <sqlite3pp/Database.hpp>
+#include <sqlite3pp/Error.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace sqlite3pp;
+using namespace std::chrono_literals;
+
+struct CheckpointManagerTest : public ::testing::Test {
+
+    std::unique_ptr<Database> db;
+
+    void SetUp() override {
+        for (const auto* file : {"checkpoint.db", "checkpoint.db-wal", "checkpoint.db-shm"}) {
+            std::remove(file);
+        }
+        db = std::make_unique<Database>("checkpoint.db");
+        db->execute("PRAGMA journal_mode=WAL");
+        db->execute("CREATE TABLE foo(a)");
+    }
+
+    void TearDown() override { db.reset(); }
+
+    template <typename Predicate>
+    static bool waitFor(const Predicate& predicate) {
+        for (auto i = 0; i < 500 && !predicate(); ++i) {
+            std::this_thread::sleep_for(10ms);
+        }
+        return predicate();
+    }
+};
+
+TEST_F(CheckpointManagerTest, MemoryDatabase) {
+    const Database memory{":memory:"};
+    ASSERT_THROW(memory.checkpointManager(), Error);
+}
+
+TEST_F(CheckpointManagerTest, DisableAutoCheckpoint) {
+    {
+        const auto manager = db->checkpointManager();
+        EXPECT_EQ(0, db->execute<int>("PRAGMA wal_autocheckpoint"));
+    }
+    EXPECT_EQ(1000, db->execute<int>("PRAGMA wal_autocheckpoint"));
+}
+
+TEST_F(CheckpointManagerTest, RestoreAutoCheckpoint) {
+    for (const auto pages : {0, 250}) {
+        db->execute("PRAGMA wal_autocheckpoint=" + std::to_string(pages));
+        {
+            const auto manager = db->checkpointManager();
+        }
+        EXPECT_EQ(pages, db->execute<int>("PRAGMA wal_autocheckpoint"));
+    }
+}
+
+TEST_F(CheckpointManagerTest, SingleManager) {
+    const auto manager = db->checkpointManager();
+    ASSERT_THROW(db->checkpointManager(), Error);
+    EXPECT_EQ(0, db->execute<int>("PRAGMA wal_autocheckpoint"));
+}
+
+TEST_F(CheckpointManagerTest, PassiveCheckpoint) {
+
+    const auto manager = db->checkpointManager({4, 1h, 1h});
+    for (auto i = 0; i < 10; ++i) {
+        db->execute("INSERT INTO foo VALUES (" + std::to_string(i) + ")");
+    }
+    ASSERT_TRUE(waitFor([&manager] { return 0 < manager.statistics().checkpoints; }));
+    const auto statistics = manager.statistics();
+    EXPECT_LT(0U, statistics.framesCheckpointed);
+    EXPECT_EQ(0U, statistics.truncations);
+    EXPECT_LT(0U, std::filesystem::file_size("checkpoint.db-wal"));
+}
+
+TEST_F(CheckpointManagerTest, TruncateWhenIdle) {
+
+    const auto manager = db->checkpointManager({1000, 10ms, 50ms});
+    db->execute("INSERT INTO foo VALUES (1)");
+    ASSERT_TRUE(waitFor([&manager] { return 0 < manager.statistics().truncations; }));
+    EXPECT_EQ(0U, manager.statistics().walFrames);
+    EXPECT_EQ(0U, std::filesystem::file_size("checkpoint.db-wal"));
+    EXPECT_EQ(1, db->execute<int>("SELECT count(*) FROM foo"));
+}
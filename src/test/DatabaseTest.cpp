@@ -24,8 +24,16 @@
 #include <sqlite3pp/Database.hpp>
 #include <sqlite3pp/Error.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <gtest/gtest.h>
 
@@ -138,6 +146,38 @@ TEST_F(DatabaseTest, ExtractSet) {
     EXPECT_EQ(T2({{1, "one"}, {2, "two"}, {3, "one"}}), db->execute<T2>("SELECT a,b FROM foo"));
 }
 
+TEST_F(DatabaseTest, ExtractUnordered) {
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1,'one'),(2,'two'),(3,'one')"));
+
+    using T1 = std::unordered_set<std::string>;
+    EXPECT_EQ(T1({"one", "two"}), db->execute<T1>("SELECT b FROM foo"));
+
+    using T2 = std::unordered_map<int, std::string>;
+    EXPECT_EQ(T2({{1, "one"}, {2, "two"}, {3, "one"}}), db->execute<T2>("SELECT a,b FROM foo"));
+
+    const auto reserved = db->execute<T2>("SELECT a,b FROM foo", 1000);
+    EXPECT_EQ(3U, reserved.size());
+    EXPECT_LE(1000U, reserved.bucket_count() * reserved.max_load_factor());
+}
+
+TEST_F(DatabaseTest, ExtractFlatMap) {
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (3,'three'),(1,'one'),(2,'two'),(1,'uno')"));
+
+    using T = FlatMap<int, std::string>;
+    const auto result = db->execute<T>("SELECT a,b FROM foo ORDER BY rowid", 10);
+    EXPECT_EQ(T({{1, "one"}, {2, "two"}, {3, "three"}}), result);
+    EXPECT_LE(10U, result.capacity());
+    EXPECT_EQ("two", result.at(2));
+    EXPECT_TRUE(result.contains(3));
+    EXPECT_EQ(result.end(), result.find(4));
+    EXPECT_THROW(result.at(4), std::out_of_range);
+
+    using V = std::vector<int>;
+    EXPECT_LE(10U, db->execute<V>("SELECT a FROM foo", 10).capacity());
+}
+
 TEST_F(DatabaseTest, ExtractBlob) {
     ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a)"));
     ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (X'DEADBEAF')"));
@@ -174,3 +214,493 @@ TEST_F(DatabaseTest, TransactionCommit) {
     ASSERT_NO_THROW(db->transaction(batch));
     ASSERT_EQ(3, db->execute<int>("SELECT count(*) FROM foo"));
 }
+
+TEST_F(DatabaseTest, QueryPlan) {
+
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("CREATE INDEX foo_a ON foo(a)"));
+
+    const auto scan = db->prepare("SELECT * FROM foo").queryPlan();
+    ASSERT_EQ(1U, scan.children.size());
+    EXPECT_EQ(0U, scan.children[0].detail.rfind("SCAN", 0));
+
+    const auto search = db->prepare("SELECT * FROM foo WHERE a = ?").queryPlan();
+    ASSERT_EQ(1U, search.children.size());
+    EXPECT_NE(std::string::npos, search.children[0].detail.find("INDEX foo_a"));
+
+    const auto nested = db->prepare("SELECT * FROM foo WHERE b IN (SELECT b FROM foo ORDER BY b)").queryPlan();
+    EXPECT_TRUE(std::any_of(nested.children.begin(), nested.children.end(),
+                            [](const auto& node) { return !node.children.empty(); }));
+}
+
+TEST_F(DatabaseTest, Diagnostics) {
+
+    std::vector<StatementDiagnostics> reports;
+    db->enableDiagnostics([&reports](const auto& report) { reports.push_back(report); });
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("CREATE INDEX foo_a ON foo(a)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1,'one'),(2,'two')"));
+    for (auto i = 0; i < 3; ++i) {
+        ASSERT_NO_THROW(db->execute<int>("SELECT count(*) FROM foo WHERE b = 'one'"));
+        ASSERT_NO_THROW(db->execute<int>("SELECT count(*) FROM foo WHERE a = 1"));
+    }
+    ASSERT_NO_THROW(db->execute<std::vector<std::string>>("SELECT b FROM foo ORDER BY b"));
+    db->transaction([](const auto& t) { t.execute("SELECT * FROM foo"); });
+    db->reportDiagnostics();
+
+    ASSERT_EQ(3U, reports.size());
+    auto find = [&reports](const std::string& sql) {
+        return std::find_if(reports.begin(), reports.end(), [&sql](const auto& report) { return report.sql == sql; });
+    };
+    const auto scan = find("SELECT count(*) FROM foo WHERE b = 'one'");
+    ASSERT_NE(reports.end(), scan);
+    EXPECT_EQ(3U, scan->executions);
+    ASSERT_EQ(1U, scan->warnings.size());
+    EXPECT_EQ(PlanWarning::Kind::FullScan, scan->warnings[0].kind);
+
+    const auto sort = find("SELECT b FROM foo ORDER BY b");
+    ASSERT_NE(reports.end(), sort);
+    EXPECT_EQ(1U, sort->executions);
+    EXPECT_TRUE(std::any_of(sort->warnings.begin(), sort->warnings.end(),
+                            [](const auto& warning) { return PlanWarning::Kind::TempBTree == warning.kind; }));
+
+    EXPECT_NE(reports.end(), find("SELECT * FROM foo"));
+}
+
+TEST_F(DatabaseTest, DiagnosticsSubqueryScans) {
+
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("CREATE INDEX foo_a ON foo(a)"));
+    auto fullScans = [this](const char* sql) {
+        const auto warnings = Diagnostics::analyze(db->prepare(sql).queryPlan());
+        return std::count_if(warnings.begin(), warnings.end(),
+                             [](const auto& warning) { return PlanWarning::Kind::FullScan == warning.kind; });
+    };
+
+    EXPECT_EQ(0, fullScans("SELECT * FROM (SELECT a FROM foo WHERE a = 1 LIMIT 2), "
+                           "(SELECT a FROM foo WHERE a = 2 LIMIT 3)"));
+    EXPECT_EQ(0, fullScans("WITH c AS MATERIALIZED (SELECT a FROM foo WHERE a = 1) SELECT * FROM c"));
+    EXPECT_EQ(0, fullScans("WITH RECURSIVE r(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM r WHERE x < 3) "
+                           "SELECT x FROM r"));
+    EXPECT_EQ(1, fullScans("SELECT * FROM (SELECT a FROM foo WHERE a = 1 LIMIT 2), foo"));
+}
+
+TEST_F(DatabaseTest, DiagnosticsHandlerUsesDatabase) {
+
+    db->enableDiagnostics([this](const auto& report) {
+        const auto stmt = db->prepare("INSERT INTO log VALUES (?)");
+        stmt.bind(1, report.sql);
+        stmt.execute();
+    });
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a)"));
+    ASSERT_NO_THROW(db->execute("CREATE TABLE log(sql)"));
+    ASSERT_NO_THROW(db->execute<std::vector<int>>("SELECT a FROM foo"));
+    db->reportDiagnostics();
+    EXPECT_EQ(1, db->execute<int>("SELECT count(*) FROM log WHERE sql = 'SELECT a FROM foo'"));
+}
+
+TEST_F(DatabaseTest, ResultCache) {
+
+    db->enableResultCache(1024 * 1024);
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1,'one'),(2,'two')"));
+
+    using T = std::map<int, std::string>;
+    EXPECT_EQ(T({{1, "one"}, {2, "two"}}), db->execute<T>("SELECT a,b FROM foo"));
+    EXPECT_EQ(T({{1, "one"}, {2, "two"}}), db->execute<T>("SELECT a,b FROM foo"));
+    EXPECT_EQ(2, db->execute<int>("SELECT count(*) FROM foo"));
+    EXPECT_EQ(2, db->execute<int>("SELECT count(*) FROM foo"));
+    EXPECT_EQ(2U, db->resultCacheStatistics().hits);
+    EXPECT_EQ(2U, db->resultCacheStatistics().entries);
+
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (3,'three')"));
+    EXPECT_EQ(3, db->execute<int>("SELECT count(*) FROM foo"));
+    EXPECT_EQ(T({{1, "one"}, {2, "two"}, {3, "three"}}), db->execute<T>("SELECT a,b FROM foo"));
+    EXPECT_EQ(2U, db->resultCacheStatistics().hits);
+}
+
+TEST_F(DatabaseTest, ResultCacheNondeterministic) {
+
+    db->enableResultCache(1024 * 1024);
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1)"));
+
+    const auto first = db->execute<std::int64_t>("SELECT a + random() FROM foo");
+    const auto second = db->execute<std::int64_t>("SELECT a + random() FROM foo");
+    EXPECT_NE(first, second);
+    ASSERT_NO_THROW(db->execute<std::string>("SELECT datetime('now') FROM foo"));
+    ASSERT_NO_THROW(db->execute<std::string>("SELECT CURRENT_TIMESTAMP FROM foo"));
+    EXPECT_EQ(0U, db->resultCacheStatistics().entries);
+}
+
+TEST_F(DatabaseTest, ResultCacheInternalTables) {
+
+    db->enableResultCache(1024 * 1024);
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(id INTEGER PRIMARY KEY AUTOINCREMENT, a)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo(a) VALUES (1)"));
+    EXPECT_EQ(1, db->execute<int>("SELECT seq FROM sqlite_sequence WHERE name = 'foo'"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo(a) VALUES (2)"));
+    EXPECT_EQ(2, db->execute<int>("SELECT seq FROM sqlite_sequence WHERE name = 'foo'"));
+    EXPECT_EQ(1, db->execute<int>("SELECT count(*) FROM sqlite_master WHERE name = 'foo'"));
+    EXPECT_EQ(0U, db->resultCacheStatistics().entries);
+}
+
+TEST_F(DatabaseTest, ResultCacheDiagnostics) {
+
+    std::size_t executions{0};
+    db->enableDiagnostics([&executions](const StatementDiagnostics& stmt) { executions = stmt.executions; });
+    db->enableResultCache(1024 * 1024);
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1)"));
+
+    for (auto i = 0; i < 5; ++i) {
+        EXPECT_EQ(1, db->execute<int>("SELECT a FROM foo"));
+    }
+    EXPECT_EQ(4U, db->resultCacheStatistics().hits);
+    db->reportDiagnostics();
+    EXPECT_EQ(5U, executions);
+}
+
+TEST_F(DatabaseTest, ResultCacheParameters) {
+
+    db->enableResultCache(1024 * 1024);
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1,'one'),(2,'two')"));
+
+    const auto stmt = db->prepare("SELECT b FROM foo WHERE a = ?");
+    stmt.bind(1, 1);
+    EXPECT_EQ("one", stmt.execute<std::string>());
+    stmt.bind(1, 2);
+    EXPECT_EQ("two", stmt.execute<std::string>());
+    stmt.bind(1, 1);
+    EXPECT_EQ("one", stmt.execute<std::string>());
+    EXPECT_EQ(1U, db->resultCacheStatistics().hits);
+    EXPECT_EQ(2U, db->resultCacheStatistics().entries);
+}
+
+TEST_F(DatabaseTest, ResultCacheInvalidation) {
+
+    db->enableResultCache(1024 * 1024);
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a PRIMARY KEY,b) WITHOUT ROWID"));
+    ASSERT_NO_THROW(db->execute("CREATE TABLE bar(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1,'one')"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO bar VALUES (1,'one')"));
+    EXPECT_EQ(1, db->execute<int>("SELECT count(*) FROM foo"));
+    EXPECT_EQ(1, db->execute<int>("SELECT count(*) FROM bar"));
+
+    // Writes to other tables keep the results
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (2,'two')"));
+    EXPECT_EQ(1, db->execute<int>("SELECT count(*) FROM bar"));
+    EXPECT_EQ(1U, db->resultCacheStatistics().hits);
+
+    // Tables without rowid are not reported by the update hook
+    EXPECT_EQ(2, db->execute<int>("SELECT count(*) FROM foo"));
+
+    // Results read within a transaction are dropped on rollback
+    auto batch = [](const auto& t) {
+        t.execute("DELETE FROM bar");
+        EXPECT_EQ(0, t.prepare("SELECT count(*) FROM bar").template execute<int>());
+        throw 42;
+    };
+    ASSERT_THROW(db->transaction(batch), int);
+    EXPECT_EQ(1, db->execute<int>("SELECT count(*) FROM bar"));
+
+    ASSERT_NO_THROW(db->execute("DROP TABLE bar"));
+    ASSERT_NO_THROW(db->execute("CREATE TABLE bar(a)"));
+    EXPECT_EQ(0, db->execute<int>("SELECT count(*) FROM bar"));
+}
+
+TEST_F(DatabaseTest, ResultCacheEviction) {
+
+    db->enableResultCache(1024);
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1, zeroblob(2048)),(2,'two')"));
+
+    // Results exceeding the capacity are never cached
+    EXPECT_EQ(2048U, db->execute<Blob>("SELECT b FROM foo WHERE a = 1").size());
+    EXPECT_EQ(0U, db->resultCacheStatistics().entries);
+
+    for (auto i = 0; i < 64; ++i) {
+        const auto suffix = std::to_string(i % 16);
+        EXPECT_EQ("two" + suffix, db->execute<std::string>("SELECT b || '" + suffix + "' FROM foo WHERE a = 2"));
+    }
+    EXPECT_GE(1024U, db->resultCacheStatistics().bytes);
+    EXPECT_LT(0U, db->resultCacheStatistics().entries);
+}
+
+TEST_F(DatabaseTest, ErrorCodes) {
+
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a UNIQUE)"));
+    try {
+        db->execute("INSERT INTO bar VALUES (1)");
+        FAIL();
+    }
+    catch (const PrepareStatementError& error) {
+        EXPECT_EQ(1, error.getCode()); // SQLITE_ERROR
+    }
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1)"));
+    try {
+        db->execute("INSERT INTO foo VALUES (1)");
+        FAIL();
+    }
+    catch (const Error& error) {
+        EXPECT_EQ(19, error.getCode());            // SQLITE_CONSTRAINT
+        EXPECT_EQ(2067, error.getExtendedCode()); // SQLITE_CONSTRAINT_UNIQUE
+    }
+}
+
+TEST_F(DatabaseTest, TryExecute) {
+
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a UNIQUE, b)"));
+    const auto stmt = db->prepare("INSERT INTO foo VALUES (?, 'one')");
+    stmt.bind(1, 1);
+    EXPECT_TRUE(stmt.tryExecute());
+
+    // Statement remains usable after the failure
+    const auto result = stmt.tryExecute();
+    ASSERT_FALSE(result);
+    EXPECT_EQ(19, result.error().code);
+    EXPECT_EQ(2067, result.error().extendedCode);
+    EXPECT_THROW(result.value(), Error);
+    stmt.bind(1, 2);
+    EXPECT_TRUE(stmt.tryExecute());
+
+    std::vector<int> values;
+    ASSERT_TRUE(db->prepare("SELECT a FROM foo ORDER BY a").tryExecute([&values](const Row& row) {
+        values.push_back(row.get<int>(0));
+    }));
+    EXPECT_EQ(std::vector<int>({1, 2}), values);
+}
+
+TEST_F(DatabaseTest, TryStepAndGet) {
+
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1,'one')"));
+    const auto stmt = db->prepare("SELECT a,b FROM foo");
+
+    const auto first = stmt.tryStep();
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(*first);
+    const auto row = stmt.row();
+    EXPECT_EQ(1, *row.tryGet<int>(0));
+    EXPECT_EQ("one", *row.tryGet<std::string>(1));
+    EXPECT_EQ(20, row.tryGet<double>(0).error().code); // SQLITE_MISMATCH
+    EXPECT_FALSE(row.tryGet<int>(2));
+    using T = std::pair<int, int>;
+    EXPECT_FALSE(row.tryGet<T>(0));
+    try {
+        row.get<T>(0);
+        FAIL();
+    }
+    catch (const TypeMismatchError& error) {
+        EXPECT_EQ(1U, error.getIndex());
+        EXPECT_EQ(20, error.getCode());
+    }
+
+    const auto second = stmt.tryStep();
+    ASSERT_TRUE(second);
+    EXPECT_FALSE(*second);
+}
+
+TEST_F(DatabaseTest, ExecutionDeadline) {
+
+    const auto stmt = db->prepare("WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c WHERE x < ?) "
+                                  "SELECT count(*) FROM c");
+    stmt.bind(1, 1000000000);
+    ASSERT_THROW(stmt.execute<int>(ExecutionLimits::timeout(std::chrono::milliseconds{20})), InterruptedError);
+
+    const auto result = stmt.tryExecute([](const auto&) {}, ExecutionLimits::timeout(std::chrono::milliseconds{20}));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(9, result.error().code); // SQLITE_INTERRUPT
+
+    // Statement is reusable and limits do not outlive the execution
+    stmt.bind(1, 1000);
+    EXPECT_EQ(1000, stmt.execute<int>(ExecutionLimits::timeout(std::chrono::seconds{10})));
+    EXPECT_EQ(1000, stmt.execute<int>());
+}
+
+TEST_F(DatabaseTest, ExecutionDeadlineNested) {
+
+    const auto stmt = db->prepare("WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c WHERE x < 1000000000) "
+                                  "SELECT x FROM c");
+    auto rows = 0;
+    const auto nested = [this, &rows](const auto&) {
+        if (0 == rows++) {
+            EXPECT_EQ(1, db->prepare("SELECT 1").execute<int>(ExecutionLimits::timeout(std::chrono::seconds{10})));
+        }
+    };
+    // Inner limits must not replace the outer deadline once they end
+    ASSERT_THROW(stmt.execute(nested, ExecutionLimits::timeout(std::chrono::milliseconds{50})), InterruptedError);
+    EXPECT_LT(1, rows);
+
+    // Outer limits apply to the inner execution as well
+    rows = 0;
+    const auto inner = [this, &rows](const auto&) {
+        if (0 == rows++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{60});
+            EXPECT_THROW(db->prepare("SELECT 1").execute<int>(ExecutionLimits::timeout(std::chrono::seconds{10})),
+                         InterruptedError);
+        }
+    };
+    ASSERT_THROW(stmt.execute(inner, ExecutionLimits::timeout(std::chrono::milliseconds{50})), InterruptedError);
+    EXPECT_EQ(1, rows);
+}
+
+TEST_F(DatabaseTest, ExecutionDeadlineOtherThread) {
+
+    // Limits of one thread do not interrupt statements of another one
+    std::promise<void> started;
+    std::thread limited{[this, &started] {
+        const auto stmt = db->prepare("WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c) SELECT x FROM c");
+        auto rows = 0;
+        const auto handler = [&started, &rows](const auto&) {
+            if (0 == rows++) {
+                started.set_value();
+            }
+        };
+        EXPECT_THROW(stmt.execute(handler, ExecutionLimits::timeout(std::chrono::milliseconds{30})), InterruptedError);
+    }};
+    started.get_future().wait();
+    const auto stmt = db->prepare("WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c WHERE x < ?) "
+                                  "SELECT count(*) FROM c");
+    stmt.bind(1, 3000000);
+    EXPECT_EQ(3000000, stmt.execute<int>());
+    limited.join();
+}
+
+TEST_F(DatabaseTest, ExecutionCancellation) {
+
+    const auto stmt = db->prepare("WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c) "
+                                  "SELECT count(*) FROM c");
+    ExecutionLimits limits;
+    limits.token = CancellationToken{};
+    std::thread canceller{[token = *limits.token] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        token.cancel();
+    }};
+    EXPECT_THROW(stmt.execute(limits), InterruptedError);
+    canceller.join();
+    EXPECT_TRUE(limits.token->isCancelled());
+
+    // Cancelled token interrupts right at the start
+    EXPECT_THROW(db->prepare("SELECT 1").execute<int>(limits), InterruptedError);
+    EXPECT_EQ(1, db->prepare("SELECT 1").execute<int>());
+}
+
+TEST_F(DatabaseTest, Serialize) {
+
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1,'one'),(2,'two')"));
+    const auto image = db->serialize();
+    ASSERT_FALSE(image.empty());
+    ASSERT_THROW(db->serialize("bar"), Error);
+
+    // Snapshot is independent of the original database
+    const auto snapshot = Database::fromImage(image);
+    ASSERT_NO_THROW(snapshot.execute("INSERT INTO foo VALUES (3,'three')"));
+    EXPECT_EQ(3, snapshot.execute<int>("SELECT count(*) FROM foo"));
+    EXPECT_EQ(2, db->execute<int>("SELECT count(*) FROM foo"));
+    EXPECT_LE(image.size(), snapshot.serialize().size());
+
+    ASSERT_THROW(Database::fromImage(Blob({0xDE, 0xAD, 0xBE, 0xAF})).execute("SELECT * FROM foo"), Error);
+
+    // Images of WAL databases are loaded in rollback mode
+    static const auto* walFile = "serialize.db";
+    std::remove(walFile);
+    const Database wal{walFile};
+    ASSERT_EQ("wal", wal.execute<std::string>("PRAGMA journal_mode=WAL"));
+    ASSERT_NO_THROW(wal.execute("CREATE TABLE foo(a,b)"));
+    ASSERT_NO_THROW(wal.execute("INSERT INTO foo VALUES (1,'one')"));
+    const auto walImage = wal.serialize();
+    ASSERT_LT(19U, walImage.size());
+    EXPECT_EQ(1, walImage[18]);
+    EXPECT_EQ(1, Database::fromImage(walImage).execute<int>("SELECT count(*) FROM foo"));
+}
+
+TEST_F(DatabaseTest, FromImageFile) {
+
+    static const auto* dbFile = "image.db";
+    for (const auto* mode : {"DELETE", "WAL"}) {
+        std::remove(dbFile);
+        ASSERT_THROW(Database::fromImage(std::filesystem::path{dbFile}), OpenDatabaseError);
+        {
+            const Database file{dbFile};
+            file.execute(std::string{"PRAGMA journal_mode="} + mode);
+            file.execute("CREATE TABLE foo(a,b)");
+            file.execute("INSERT INTO foo VALUES (1,'one'),(2,'two')");
+        }
+
+        const auto copy = Database::fromImage(std::filesystem::path{dbFile});
+        ASSERT_NO_THROW(copy.execute("INSERT INTO foo VALUES (3,'three')"));
+        EXPECT_EQ(3, copy.execute<int>("SELECT count(*) FROM foo"));
+
+        const auto mapped = Database::fromImage(std::filesystem::path{dbFile}, true);
+        EXPECT_EQ(2, mapped.execute<int>("SELECT count(*) FROM foo"));
+        EXPECT_THROW(mapped.execute("INSERT INTO foo VALUES (3,'three')"), Error);
+        EXPECT_EQ(Database{dbFile}.serialize(), mapped.serialize());
+    }
+    // The file itself is left in WAL mode
+    EXPECT_EQ("wal", Database{dbFile}.execute<std::string>("PRAGMA journal_mode"));
+}
+
+TEST_F(DatabaseTest, ExtractWideTypes) {
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a INTEGER, b REAL, c TEXT)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (5000000000, 2.5, 'one'), (-1, NULL, NULL), (1, 0.5, '2')"));
+
+    using I = std::vector<std::int64_t>;
+    EXPECT_EQ(I({5000000000, -1, 1}), db->execute<I>("SELECT a FROM foo"));
+    EXPECT_THROW(db->execute<int>("SELECT a FROM foo LIMIT 1"), TypeMismatchError);
+    EXPECT_EQ(4000000000U, db->execute<std::uint32_t>("SELECT 4000000000"));
+    EXPECT_THROW(db->execute<std::uint32_t>("SELECT -1"), TypeMismatchError);
+    EXPECT_TRUE(db->execute<bool>("SELECT a FROM foo LIMIT 1"));
+    EXPECT_FALSE(db->execute<bool>("SELECT 0"));
+    EXPECT_EQ(2.5F, db->execute<float>("SELECT b FROM foo LIMIT 1"));
+
+    using O = std::vector<std::optional<double>>;
+    EXPECT_EQ(O({2.5, std::nullopt, 0.5}), db->execute<O>("SELECT b FROM foo"));
+    using P = std::map<std::int64_t, std::optional<std::string>>;
+    EXPECT_EQ(P({{-1, std::nullopt}, {1, "2"}, {5000000000, "one"}}), db->execute<P>("SELECT a,c FROM foo"));
+    EXPECT_THROW(db->execute<std::vector<double>>("SELECT b FROM foo"), TypeMismatchError);
+    using Q = std::pair<int, std::optional<int>>;
+    EXPECT_THROW(db->execute<Q>("SELECT 1"), TypeMismatchError);
+    EXPECT_EQ(Q(1, std::nullopt), db->execute<Q>("SELECT 1, NULL"));
+}
+
+TEST_F(DatabaseTest, ExtractWithAffinity) {
+    ASSERT_NO_THROW(db->execute("CREATE TABLE foo(a INTEGER, b REAL, c TEXT, d)"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES (1, 2, '3', '4')"));
+
+    // Strict conversion is the default
+    EXPECT_THROW(db->execute<double>("SELECT a FROM foo"), TypeMismatchError);
+    EXPECT_THROW(db->execute<std::string>("SELECT a FROM foo"), TypeMismatchError);
+
+    auto stmt = db->prepare("SELECT a,b,c,d FROM foo");
+    stmt.setConversion(Conversion::Affinity);
+    using T = std::pair<std::pair<double, int>, std::pair<std::string, int>>;
+    EXPECT_EQ(T({1.0, 2}, {"3", 4}), stmt.execute<T>());
+
+    db->setConversion(Conversion::Affinity);
+    EXPECT_EQ("1", db->execute<std::string>("SELECT a FROM foo"));
+    db->transaction([](const Transaction& t) {
+        EXPECT_EQ("1", t.prepare("SELECT a FROM foo").execute<std::string>());
+    });
+    EXPECT_EQ(Blob({'3'}), db->execute<Blob>("SELECT c FROM foo"));
+    EXPECT_EQ(3, db->execute<int>("SELECT c FROM foo"));
+    EXPECT_EQ(12, db->execute<int>("SELECT '12'"));
+    EXPECT_EQ(2.5, db->execute<double>("SELECT ' 2.5 '"));
+    EXPECT_THROW(db->execute<int>("SELECT X'00'"), TypeMismatchError);
+    EXPECT_THROW(db->execute<int>("SELECT NULL"), TypeMismatchError);
+    EXPECT_EQ(std::nullopt, db->execute<std::optional<int>>("SELECT NULL"));
+
+    // Text, which is not a number, does not match in any column
+    ASSERT_NO_THROW(db->execute("DELETE FROM foo"));
+    ASSERT_NO_THROW(db->execute("INSERT INTO foo VALUES ('abc', 'xyz', 'abc', 'abc'), ('12abc', '', '1x', '1x')"));
+    using V = std::vector<std::string>;
+    EXPECT_EQ(V({"abc", "12abc"}), db->execute<V>("SELECT a FROM foo"));
+    for (const auto* column : {"a", "c", "d"}) {
+        EXPECT_THROW(db->execute<std::vector<int>>(std::string{"SELECT "} + column + " FROM foo"), TypeMismatchError);
+    }
+    EXPECT_THROW(db->execute<std::vector<double>>("SELECT b FROM foo"), TypeMismatchError);
+    EXPECT_THROW(db->execute<int>("SELECT 'hello'"), TypeMismatchError);
+    EXPECT_THROW(db->execute<int>("SELECT '12abc'"), TypeMismatchError);
+}
@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Filipp Andjelo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifdef SQLITE3PP_WITH_SESSION
+
+#include <sqlite3pp/Database.hpp>
+#include <sqlite3pp/Error.hpp>
+
+#include <cstdio>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+using namespace sqlite3pp;
+
+struct SessionTest : public ::testing::Test {
+
+    std::unique_ptr<Database> source;
+    std::unique_ptr<Database> replica;
+
+    void SetUp() override {
+        std::remove("source.db");
+        std::remove("replica.db");
+        source = std::make_unique<Database>("source.db");
+        replica = std::make_unique<Database>("replica.db");
+        for (const auto* db : {source.get(), replica.get()}) {
+            db->execute("CREATE TABLE foo(a PRIMARY KEY, b)");
+            db->execute("CREATE TABLE bar(a PRIMARY KEY, b)");
+            db->execute("INSERT INTO foo VALUES (1,'one'),(2,'two')");
+        }
+    }
+
+    void TearDown() override {
+        source.reset();
+        replica.reset();
+    }
+};
+
+TEST_F(SessionTest, Changeset) {
+
+    const auto session = source->session();
+    session.attach("foo");
+    ASSERT_TRUE(session.isEmpty());
+    ASSERT_NO_THROW(source->execute("INSERT INTO foo VALUES (3,'three')"));
+    ASSERT_NO_THROW(source->execute("UPDATE foo SET b = 'uno' WHERE a = 1"));
+    ASSERT_NO_THROW(source->execute("DELETE FROM foo WHERE a = 2"));
+    ASSERT_NO_THROW(source->execute("INSERT INTO bar VALUES (1,'ignored')"));
+    ASSERT_FALSE(session.isEmpty());
+
+    ASSERT_NO_THROW(replica->applyChangeset(session.changeset()));
+    using T = std::map<int, std::string>;
+    EXPECT_EQ(T({{1, "uno"}, {3, "three"}}), replica->execute<T>("SELECT a,b FROM foo"));
+    EXPECT_EQ(0, replica->execute<int>("SELECT count(*) FROM bar"));
+}
+
+TEST_F(SessionTest, Patchset) {
+
+    const auto session = source->session();
+    session.attach();
+    ASSERT_NO_THROW(source->execute("UPDATE foo SET b = 'dos' WHERE a = 2"));
+    ASSERT_NO_THROW(source->execute("INSERT INTO bar VALUES (1,'one')"));
+
+    const auto patchset = session.patchset();
+    EXPECT_LT(patchset.size(), session.changeset().size());
+    ASSERT_NO_THROW(replica->applyChangeset(patchset));
+    EXPECT_EQ("dos", replica->execute<std::string>("SELECT b FROM foo WHERE a = 2"));
+    EXPECT_EQ("one", replica->execute<std::string>("SELECT b FROM bar WHERE a = 1"));
+}
+
+TEST_F(SessionTest, Conflicts) {
+
+    const auto session = source->session();
+    session.attach();
+    ASSERT_NO_THROW(source->execute("UPDATE foo SET b = 'uno' WHERE a = 1"));
+    ASSERT_NO_THROW(source->execute("INSERT INTO bar VALUES (1,'one')"));
+    const auto changeset = session.changeset();
+
+    ASSERT_NO_THROW(replica->execute("UPDATE foo SET b = 'eins' WHERE a = 1"));
+    ASSERT_NO_THROW(replica->execute("INSERT INTO bar VALUES (1,'ein')"));
+
+    // Conflicts abort without handler and leave the database untouched
+    ASSERT_THROW(replica->applyChangeset(changeset), SessionError);
+    EXPECT_EQ("eins", replica->execute<std::string>("SELECT b FROM foo WHERE a = 1"));
+
+    std::vector<Conflict> conflicts;
+    ASSERT_NO_THROW(replica->applyChangeset(changeset, [&conflicts](const Conflict& conflict) {
+        conflicts.push_back(conflict);
+        return "foo" == conflict.table ? ConflictAction::Replace : ConflictAction::Omit;
+    }));
+    ASSERT_EQ(2U, conflicts.size());
+    EXPECT_EQ(Conflict::Type::Data, conflicts[0].type);
+    EXPECT_EQ(Conflict::Operation::Update, conflicts[0].operation);
+    EXPECT_EQ(Conflict::Type::Conflict, conflicts[1].type);
+    EXPECT_EQ(Conflict::Operation::Insert, conflicts[1].operation);
+    EXPECT_EQ("uno", replica->execute<std::string>("SELECT b FROM foo WHERE a = 1"));
+    EXPECT_EQ("ein", replica->execute<std::string>("SELECT b FROM bar WHERE a = 1"));
+
+    ASSERT_THROW(replica->applyChangeset(changeset, [](const auto&) -> ConflictAction { throw 42; }), int);
+}
+
+#endif // SQLITE3PP_WITH_SESSION
@@ -23,6 +23,10 @@
  */
 #include <sqlite3pp/Database.hpp>
 
+#ifdef SQLITE3PP_HEADER_ONLY
+#error "sqlite3pp::sqlite3pp must link the regular library, not the inline one"
+#endif
+
 int main() {
     sqlite3pp::Database db{":memory:"};
     return 0;